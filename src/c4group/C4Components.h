@@ -141,11 +141,13 @@
 #define C4CFN_Log             "OpenClonk.log"
 #define C4CFN_LogEx           "OpenClonk%d.log" // created if regular logfile is in use
 #define C4CFN_LogShader       "OpenClonkShaders.log" // created in editor mode to dump shader code
+#define C4CFN_Benchmark       "Benchmark.json" // default result file of --benchmark runs
 #define C4CFN_Intro           "Clonk4.avi"
 #define C4CFN_Names           "Names.txt"
 #define C4CFN_Titles          "Title*.txt|Title.txt"
 #define C4CFN_DefNameFiles    "Names*.txt|Names.txt"
 #define C4CFN_EditorGeometry  "Editor.geometry"
+#define C4CFN_ScriptCache     "ScriptCache.bin"
 #define C4CFN_DefaultScenarioTemplate "Empty.ocs"
 
 #define C4CFN_TempMusic       "~Music.tmp"
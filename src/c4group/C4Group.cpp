@@ -432,6 +432,9 @@ struct C4Group::P
 	bool Modified = false;
 	C4GroupEntry *FirstEntry = nullptr;
 	BYTE *pInMemEntry = nullptr; size_t iInMemEntrySize = 0; // for reading from entries prefetched into memory
+	std::vector<BYTE> InflatedEntry; // last accessed compressed entry of an indexed group
+	std::shared_ptr<MappedFile> Mapping; // uncompressed group file, for reading entries in place
+	std::vector<std::shared_ptr<MappedFile>> EntryMappings; // folder only: entry files read in place
 #ifdef _DEBUG
 	StdStrBuf sPrevAccessedEntry;
 #endif
@@ -604,8 +607,10 @@ bool C4Group::OpenRealGrpFile()
 	int cnt,file_entries;
 	C4GroupEntryCore corebuf;
 
-	// Open StdFile
-	if (!p->StdFile.Open(GetName(),true)) return Error("OpenRealGrpFile: Cannot open standard file");
+	// Open StdFile (indexed groups are not compressed as a whole)
+	if (!p->StdFile.Open(GetName(),true))
+		if (!p->StdFile.Open(GetName(),false))
+			return Error("OpenRealGrpFile: Cannot open standard file");
 
 	// Read header
 	if (!p->StdFile.Read((BYTE*)&Head,sizeof(C4GroupHeader))) return Error("OpenRealGrpFile: Error reading header");
@@ -614,7 +619,7 @@ bool C4Group::OpenRealGrpFile()
 
 	// Check Header
 	if (!SEqual(Head.id,C4GroupFileID)
-	    || (Head.Ver1!=C4GroupFileVer1) || (Head.Ver2>C4GroupFileVer2))
+	    || (Head.Ver1!=C4GroupFileVer1) || (Head.Ver2>C4GroupFileVer2Indexed))
 		return Error("OpenRealGrpFile: Invalid header");
 
 	// Read Entries
@@ -633,7 +638,8 @@ bool C4Group::OpenRealGrpFile()
 		              corebuf.FileName,corebuf.Size,
 		              entryname.getData(),
 		              nullptr, false, false,
-		              !!corebuf.Executable))
+		              !!corebuf.Executable, false,
+		              (IsIndexed() && corebuf.Packed) ? corebuf.PackedSize : 0))
 			return Error("OpenRealGrpFile: Cannot add entry");
 	}
 
@@ -649,7 +655,8 @@ bool C4Group::AddEntry(C4GroupEntry::EntryStatus status,
                        bool fDeleteOnDisk,
                        bool fHoldBuffer,
                        bool fExecutable,
-                       bool fBufferIsStdbuf)
+                       bool fBufferIsStdbuf,
+                       long packedsize)
 {
 
 	// Folder: add file to folder immediately
@@ -716,13 +723,15 @@ bool C4Group::AddEntry(C4GroupEntry::EntryStatus status,
 	if (entryname) SCopy(entryname,nentry->FileName,_MAX_FNAME);
 	else SCopy(GetFilename(fname),nentry->FileName,_MAX_FNAME);
 	nentry->Size=size;
+	nentry->Packed=(packedsize > 0);
+	nentry->PackedSize=packedsize;
 	nentry->ChildGroup=childgroup;
 	nentry->Offset=0;
 	nentry->Executable=fExecutable;
 	nentry->DeleteOnDisk=fDeleteOnDisk;
 	nentry->HoldBuffer=fHoldBuffer;
 	nentry->BufferIsStdbuf=fBufferIsStdbuf;
-	if (lentry) nentry->Offset=lentry->Offset+lentry->Size;
+	if (lentry) nentry->Offset=lentry->Offset+lentry->GetStoredSize();
 
 	// Init list entry data
 	SCopy(fname,nentry->DiskPath,_MAX_FNAME);
@@ -777,7 +786,7 @@ bool C4Group::Close()
 
 	// Set new version
 	Head.Ver1=C4GroupFileVer1;
-	Head.Ver2=C4GroupFileVer2;
+	Head.Ver2=IsIndexed() ? C4GroupFileVer2Indexed : C4GroupFileVer2;
 
 	// Automatic sort
 	SortByList(C4Group_SortList);
@@ -803,6 +812,11 @@ bool C4Group::Save(bool fReOpen)
 	char szTempFileName[_MAX_FNAME+1],szGrpFileName[_MAX_FNAME+1];
 
 	// Create temporary core list with new actual offsets to be saved
+	// Indexed groups compress their entries one by one, which has to happen up front
+	// so the core list knows how much space each entry takes. The entry data is kept
+	// so the group doesn't have to be read (and possibly rewound) a second time.
+	bool fIndexed = IsIndexed();
+	std::vector<StdBuf> EntryData(Head.Entries);
 	int32_t iContentsSize = 0;
 	save_core = new C4GroupEntryCore [Head.Entries];
 	cscore=0;
@@ -810,9 +824,28 @@ bool C4Group::Save(bool fReOpen)
 		if (centry->Status != C4GroupEntry::C4GRES_Deleted)
 		{
 			save_core[cscore]=(C4GroupEntryCore)*centry;
+			// Entries that are already compressed are copied as they are
+			if (!fIndexed || !centry->Packed)
+			{
+				save_core[cscore].Packed = 0;
+				save_core[cscore].PackedSize = 0;
+				if (fIndexed && !centry->ChildGroup && centry->Size > 0)
+				{
+					StdBuf Packed;
+					if (!ReadEntryData(centry, EntryData[cscore]) || !DeflateEntry(EntryData[cscore], Packed))
+						{ delete [] save_core; return false; }
+					// Store uncompressed if it's not worth unpacking on every access
+					if (Packed.getSize() < size_t(centry->Size) / 8 * 7)
+					{
+						save_core[cscore].Packed = 1;
+						save_core[cscore].PackedSize = Packed.getSize();
+						EntryData[cscore] = std::move(Packed);
+					}
+				}
+			}
 			// Make actual offset
 			save_core[cscore].Offset = iContentsSize;
-			iContentsSize += centry->Size;
+			iContentsSize += save_core[cscore].GetStoredSize();
 			cscore++;
 		}
 
@@ -835,7 +868,7 @@ bool C4Group::Save(bool fReOpen)
 
 	// Create the new (temp) group file
 	CStdFile tfile;
-	if (!tfile.Create(szTempFileName,true,false,fToMemory))
+	if (!tfile.Create(szTempFileName,p->Mother || !fIndexed,false,fToMemory))
 		{  delete [] save_core; return Error("Close: ..."); }
 
 	// Save header and core list
@@ -849,13 +882,28 @@ bool C4Group::Save(bool fReOpen)
 	// Save Entries to temp file
 	int iTotalSize=0,iSizeDone=0;
 	for (centry=p->FirstEntry; centry; centry=centry->Next) iTotalSize+=centry->Size;
+	cscore=0;
 	for (centry=p->FirstEntry; centry; centry=centry->Next)
-		if (AppendEntry2StdFile(centry,tfile))
+	{
+		bool fOkay;
+		StdBuf *pData = (centry->Status != C4GroupEntry::C4GRES_Deleted) ? &EntryData[cscore++] : nullptr;
+		if (pData && pData->getSize())
+		{
+			fOkay = tfile.Write(pData->getData(), pData->getSize()) || Error("Close: Cannot write entry");
+			pData->Clear();
+			// Erase disk source if requested (as AppendEntry2StdFile would)
+			if (fOkay && centry->Status == C4GroupEntry::C4GRES_OnDisk && centry->DeleteOnDisk)
+				EraseItem(centry->DiskPath);
+		}
+		else
+			fOkay = AppendEntry2StdFile(centry,tfile,fIndexed);
+		if (fOkay)
 			{ iSizeDone+=centry->Size; if (iTotalSize && p->fnProcessCallback) p->fnProcessCallback(centry->FileName,100*iSizeDone/iTotalSize); }
 		else
 		{
 			tfile.Close(); return false;
 		}
+	}
 
 	// Write
 	StdBuf *pBuf;
@@ -920,11 +968,11 @@ void C4Group::Clear()
 	Init();
 }
 
-bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
+bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget, bool fKeepPacked)
 {
 	CStdFile hSource;
 	long csize;
-	BYTE fbuf;
+	BYTE fbuf[4096];
 
 	switch (centry->Status)
 	{
@@ -932,11 +980,20 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
 	case C4GroupEntry::C4GRES_InGroup: // Copy from group to std file
 		if (!SetFilePtr(centry->Offset))
 			return Error("AE2S: Cannot set file pointer");
-		for (csize=centry->Size; csize>0; csize--)
+		// Compressed entry of an indexed group: only copied as-is into other indexed groups
+		if (centry->Packed && !fKeepPacked)
+		{
+			if (!InflateEntry(centry)) return false;
+			if (!hTarget.Write(p->pInMemEntry,centry->Size))
+				return Error("AE2S: Cannot write to target file");
+			break;
+		}
+		for (csize=centry->GetStoredSize(); csize>0; csize-=sizeof(fbuf))
 		{
-			if (!Read(&fbuf,1))
+			size_t iChunk = std::min<long>(csize, sizeof(fbuf));
+			if (!Read(fbuf,iChunk))
 				return Error("AE2S: Cannot read entry from group file");
-			if (!hTarget.Write(&fbuf,1))
+			if (!hTarget.Write(fbuf,iChunk))
 				return Error("AE2S: Cannot write to target file");
 		}
 		break;
@@ -972,14 +1029,16 @@ bool C4Group::AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &hTarget)
 					SortGrp.Close();
 				}
 
-		// Append disk source to target file
+		// Append disk source to target file (indexed child groups are not compressed as a whole)
 		if (!hSource.Open(szFileSource, !!centry->ChildGroup))
-			return Error("AE2S: Cannot open on-disk file");
-		for (csize=centry->Size; csize>0; csize--)
+			if (!centry->ChildGroup || !hSource.Open(szFileSource, false))
+				return Error("AE2S: Cannot open on-disk file");
+		for (csize=centry->Size; csize>0; csize-=sizeof(fbuf))
 		{
-			if (!hSource.Read(&fbuf,1))
+			size_t iChunk = std::min<long>(csize, sizeof(fbuf));
+			if (!hSource.Read(fbuf,iChunk))
 				{ hSource.Close(); return Error("AE2S: Cannot read on-disk file"); }
-			if (!hTarget.Write(&fbuf,1))
+			if (!hTarget.Write(fbuf,iChunk))
 				{ hSource.Close(); return Error("AE2S: Cannot write to target file"); }
 		}
 		hSource.Close();
@@ -1088,6 +1147,9 @@ bool C4Group::SetFilePtr(int iOffset)
 	if (p->SourceType==P::ST_Unpacked)
 		return Error("SetFilePtr not implemented for Folders");
 
+	// read from file from now on
+	p->pInMemEntry = nullptr;
+
 	// ensure mother is at correct pos
 	if (p->Mother) p->Mother->EnsureChildFilePtr(this);
 
@@ -1160,6 +1222,63 @@ bool C4Group::Read(void *pBuffer, size_t iSize)
 	return true;
 }
 
+bool C4Group::ReadView(StdBuf &Buf, size_t iSize)
+{
+	const BYTE *pData = nullptr;
+	// Uncompressed data in packed groups can be read from the mapped group file,
+	// entry files of folders can be mapped as a whole
+	if (!p->pInMemEntry && iSize)
+	{
+		if (p->SourceType == P::ST_Packed)
+		{
+			size_t iDataSize;
+			const BYTE *pGroupData = MapData(iDataSize);
+			if (pGroupData && size_t(p->FilePtr) + iSize <= iDataSize)
+			{
+				pData = pGroupData + p->FilePtr;
+				if (!AdvanceFilePtr(iSize)) return Error("ReadView: Cannot advance file pointer");
+			}
+		}
+		else if (p->SourceType == P::ST_Unpacked && iSize == p->iCurrFileSize)
+		{
+			auto Mapping = std::make_shared<MappedFile>();
+			if (Mapping->Open(p->StdFile.Name) && Mapping->getSize() == iSize && p->StdFile.Advance(iSize))
+			{
+				pData = Mapping->getData();
+				p->EntryMappings.push_back(std::move(Mapping));
+			}
+		}
+	}
+	// Fall back to reading a copy
+	if (!pData) return CStdStream::ReadView(Buf, iSize);
+	Buf.Ref(pData, iSize);
+	return true;
+}
+
+const BYTE *C4Group::MapData(size_t &iSize)
+{
+	// Child group: inside the data of the mother
+	if (p->Mother && p->Mother->IsPacked())
+	{
+		size_t iMotherSize;
+		const BYTE *pMotherData = p->Mother->MapData(iMotherSize);
+		size_t iStart = p->MotherOffset + p->EntryOffset;
+		if (!pMotherData || iStart > iMotherSize) return nullptr;
+		iSize = iMotherSize - iStart;
+		return pMotherData + iStart;
+	}
+	// Outermost group file: only uncompressed if indexed
+	if (!IsIndexed()) return nullptr;
+	if (!p->Mapping)
+	{
+		p->Mapping = std::make_shared<MappedFile>();
+		p->Mapping->Open(GetFullName().getData());
+	}
+	if (!p->Mapping->getData() || size_t(p->EntryOffset) > p->Mapping->getSize()) return nullptr;
+	iSize = p->Mapping->getSize() - p->EntryOffset;
+	return p->Mapping->getData() + p->EntryOffset;
+}
+
 bool C4Group::AdvanceFilePtr(int iOffset)
 {
 	// Child group file: pass command to mother
@@ -1197,7 +1316,7 @@ bool C4Group::RewindFilePtr()
 {
 
 #ifdef _DEBUG
-	if (szCurrAccessedEntry && !iC4GroupRewindFilePtrNoWarn)
+	if (szCurrAccessedEntry && !iC4GroupRewindFilePtrNoWarn && !IsSeekable())
 	{
 		LogF("C4Group::RewindFilePtr() for %s (%s) after %s", szCurrAccessedEntry ? szCurrAccessedEntry : "???", GetName(), p->sPrevAccessedEntry.getLength() ? p->sPrevAccessedEntry.getData() : "???");
 		szCurrAccessedEntry=nullptr;
@@ -1642,6 +1761,7 @@ bool C4Group::OpenAsChild(C4Group *pMother,
 		{
 			// Create - will be added to mother in Close()
 			p->SourceType=P::ST_Packed; p->Modified=true;
+			if (p->Mother->IsIndexed()) Head.Ver2=C4GroupFileVer2Indexed;
 			return true;
 		}
 	}
@@ -1662,7 +1782,7 @@ bool C4Group::OpenAsChild(C4Group *pMother,
 
 	// Check Header
 	if (!SEqual(Head.id,C4GroupFileID)
-	    || (Head.Ver1!=C4GroupFileVer1) || (Head.Ver2>C4GroupFileVer2))
+	    || (Head.Ver1!=C4GroupFileVer1) || (Head.Ver2>C4GroupFileVer2Indexed))
 		{ CloseExclusiveMother(); Clear(); return Error("OpenAsChild: Invalid Header"); }
 
 	// Read Entries
@@ -1677,7 +1797,8 @@ bool C4Group::OpenAsChild(C4Group *pMother,
 		if (!AddEntry(C4GroupEntry::C4GRES_InGroup, !!corebuf.ChildGroup,
 		              corebuf.FileName,corebuf.Size,
 		              nullptr, nullptr, false, false,
-		              !!corebuf.Executable))
+		              !!corebuf.Executable, false,
+		              (IsIndexed() && corebuf.Packed) ? corebuf.PackedSize : 0))
 			{ CloseExclusiveMother(); Clear(); return Error("OpenAsChild: Insufficient memory"); }
 	}
 
@@ -1756,13 +1877,18 @@ bool C4Group::SetFilePtr2Entry(const char *szName, bool NeedsToBeAGroup)
 
 	case P::ST_Packed:
 		if ((!centry) || (centry->Status != C4GroupEntry::C4GRES_InGroup)) return false;
-		return SetFilePtr(centry->Offset);
+		if (!SetFilePtr(centry->Offset)) return false;
+		// Compressed entry: unpack and read from memory
+		if (centry->Packed) return !NeedsToBeAGroup && InflateEntry(centry);
+		return true;
 
 	case P::ST_Unpacked: {
 		p->StdFile.Close();
 		char path[_MAX_FNAME+1]; SCopy(GetName(),path,_MAX_FNAME);
 		AppendBackslash(path); SAppend(szName,path);
 		bool fSuccess = p->StdFile.Open(path, NeedsToBeAGroup);
+		// Indexed child groups are not compressed as a whole
+		if (!fSuccess && NeedsToBeAGroup) fSuccess = p->StdFile.Open(path, false);
 		return fSuccess;
 	}
 
@@ -1929,6 +2055,20 @@ bool C4Group::LoadEntry(const char *szEntryName, StdBuf * Buf)
 	return true;
 }
 
+bool C4Group::LoadEntryView(const char *szEntryName, StdBuf * Buf)
+{
+	size_t size;
+	// Access entry, reference data if possible
+	if (!AccessEntry(szEntryName,&size)) return Error("LoadEntry: Not found");
+	if (!ReadView(*Buf, size))
+	{
+		Buf->Clear();
+		return Error("LoadEntry: Reading error");
+	}
+	// ok
+	return true;
+}
+
 bool C4Group::LoadEntryString(const char *szEntryName, StdStrBuf *Buf)
 {
 	size_t size;
@@ -2010,6 +2150,45 @@ bool C4Group::IsPacked() const { return p->SourceType == P::ST_Packed; }
 
 bool C4Group::HasPackedMother() const { if (!p->Mother) return false; return p->Mother->IsPacked(); }
 
+bool C4Group::IsIndexed() const { return Head.Ver2 == C4GroupFileVer2Indexed; }
+
+bool C4Group::IsSeekable() const
+{
+	// packed data is read from the file of the outermost packed group, which is only
+	// uncompressed (and thus seekable) if that group is indexed
+	if (p->Mother && p->Mother->IsPacked()) return p->Mother->IsSeekable();
+	return IsIndexed();
+}
+
+bool C4Group::SetIndexed(bool fIndexed, bool fRecursive)
+{
+	if (p->SourceType != P::ST_Packed) return Error("SetIndexed: Not a group file");
+	if (fRecursive)
+	{
+		// Collect names first, as rewriting a child group replaces its entry
+		// (children that were just added are written in their own format)
+		std::vector<std::string> Children;
+		for (C4GroupEntry *centry = p->FirstEntry; centry; centry = centry->Next)
+			if (centry->ChildGroup && centry->Status == C4GroupEntry::C4GRES_InGroup)
+				Children.emplace_back(centry->FileName);
+		for (const std::string &Name : Children)
+		{
+			C4Group Child;
+			Child.SetStdOutput(p->StdOutput);
+			if (!Child.OpenAsChild(this, Name.c_str()))
+				return Error(FormatString("SetIndexed: Cannot open child group %s", Name.c_str()).getData());
+			if (!Child.SetIndexed(fIndexed, true) || !Child.Close())
+				return Error(Child.GetError());
+		}
+	}
+	if (fIndexed != IsIndexed())
+	{
+		Head.Ver2 = fIndexed ? C4GroupFileVer2Indexed : C4GroupFileVer2;
+		p->Modified = true;
+	}
+	return true;
+}
+
 bool C4Group::SetNoSort(bool fNoSort) { p->NoSort = fNoSort; return true; }
 
 bool C4Group::CloseExclusiveMother()
@@ -2046,6 +2225,9 @@ bool C4Group::SortByList(const char **ppSortList, const char *szFilename)
 bool C4Group::EnsureChildFilePtr(C4Group *pChild)
 {
 
+	// the child reads from file
+	p->pInMemEntry = nullptr;
+
 	// group file
 	if (p->SourceType == P::ST_Packed)
 	{
@@ -2165,6 +2347,7 @@ bool C4Group::OpenChild(const char* strEntry)
 	// Create a memory copy of ourselves
 	C4Group *pOurselves = new C4Group;
 	*pOurselves->p = *p;
+	pOurselves->Head = Head;
 
 	// Open a child from the memory copy
 	C4Group hChild;
@@ -2182,6 +2365,7 @@ bool C4Group::OpenChild(const char* strEntry)
 
 	// We now become our own child
 	*p = *hChild.p;
+	Head = hChild.Head;
 
 	// Make ourselves exclusive (until we hit our memory copy parent)
 	for (C4Group *pGroup = this; pGroup != pOurselves; pGroup = pGroup->p->Mother)
@@ -2242,17 +2426,105 @@ int C4Group::PreCacheEntries(const char *szSearchPattern, bool cache_previous)
 	return result;
 }
 
+bool C4Group::CanPreCacheConcurrently()
+{
+	// Folders read each entry from its own file and indexed groups from their
+	// mapping (which is set up right here). Classic packed groups share the
+	// file pointer with their mother and all siblings.
+	if (p->SourceType == P::ST_Unpacked) return true;
+	size_t iDataSize;
+	return p->SourceType == P::ST_Packed && MapData(iDataSize);
+}
+
 const C4GroupHeader &C4Group::GetHeader() const { return Head; }
 
 const C4GroupEntry *C4Group::GetFirstEntry() const { return p->FirstEntry; }
 
+bool C4Group::InflateEntry(C4GroupEntry *centry)
+{
+	// file pointer must be at the start of the entry
+	StdBuf Packed;
+	Packed.New(centry->PackedSize);
+	if (!Read(Packed.getMData(), Packed.getSize())) return Error("InflateEntry: Cannot read entry");
+	p->InflatedEntry.resize(centry->Size);
+	uLongf iSize = centry->Size;
+	if (uncompress(p->InflatedEntry.data(), &iSize, getBufPtr<Bytef>(Packed), Packed.getSize()) != Z_OK
+	    || iSize != uLongf(centry->Size))
+		return Error("InflateEntry: Corrupt entry");
+	p->pInMemEntry = p->InflatedEntry.data();
+	p->iInMemEntrySize = centry->Size;
+	return true;
+}
+
+bool C4Group::ReadEntryData(C4GroupEntry *centry, StdBuf &Data)
+{
+	// Get uncompressed contents of a non-group entry, wherever it is
+	switch (centry->Status)
+	{
+	case C4GroupEntry::C4GRES_InGroup:
+		if (centry->bpMemBuf) { Data.Ref(centry->bpMemBuf, centry->Size); return true; }
+		if (!SetFilePtr(centry->Offset)) return Error("ReadEntryData: Cannot set file pointer");
+		if (centry->Packed)
+		{
+			if (!InflateEntry(centry)) return false;
+			Data.Copy(p->pInMemEntry, centry->Size);
+			return true;
+		}
+		Data.New(centry->Size);
+		if (!Read(Data.getMData(), Data.getSize())) return Error("ReadEntryData: Cannot read entry from group file");
+		return true;
+	case C4GroupEntry::C4GRES_OnDisk:
+		if (!Data.LoadFromFile(centry->DiskPath) || Data.getSize() != size_t(centry->Size))
+			return Error("ReadEntryData: Cannot read on-disk file");
+		return true;
+	case C4GroupEntry::C4GRES_InMemory:
+		if (!centry->bpMemBuf) return Error("ReadEntryData: no buffer");
+		Data.Ref(centry->bpMemBuf, centry->Size);
+		return true;
+	default:
+		return Error("ReadEntryData: Unknown file status");
+	}
+}
+
+bool C4Group::DeflateEntry(const StdBuf &Data, StdBuf &Packed)
+{
+	uLongf iPackedSize = compressBound(Data.getSize());
+	Packed.New(iPackedSize);
+	if (compress2(getMBufPtr<Bytef>(Packed), &iPackedSize, getBufPtr<Bytef>(Data), Data.getSize(), Z_DEFAULT_COMPRESSION) != Z_OK)
+		return Error("DeflateEntry: Compression failed");
+	Packed.SetSize(iPackedSize);
+	return true;
+}
+
 void C4Group::PreCacheEntry(C4GroupEntry * e)
 {
 	// skip some stuff that can not be cached or has already been cached
 	if (e->ChildGroup || e->bpMemBuf || !e->Size) return;
 	// now load it!
 	StdBuf buf;
-	if (!this->LoadEntry(e->FileName, &buf)) return;
+	size_t iDataSize;
+	const BYTE *pData;
+	if (e->Status == C4GroupEntry::C4GRES_OnDisk)
+	{
+		// folder entries: read the file directly without going through the group's file
+		if (!buf.LoadFromFile(e->DiskPath)) return;
+	}
+	else if (e->Status == C4GroupEntry::C4GRES_InGroup && p->SourceType == P::ST_Packed
+	         && (pData = MapData(iDataSize)) && size_t(e->Offset) + e->GetStoredSize() <= iDataSize)
+	{
+		// indexed groups: copy or inflate from the mapping without touching any file pointers
+		if (!e->Packed)
+			buf.Copy(pData + e->Offset, e->Size);
+		else
+		{
+			buf.New(e->Size);
+			uLongf iSize = e->Size;
+			if (uncompress(getMBufPtr<Bytef>(buf), &iSize, pData + e->Offset, e->PackedSize) != Z_OK
+			    || iSize != uLongf(e->Size))
+				return;
+		}
+	}
+	else if (!this->LoadEntry(e->FileName, &buf)) return;
 	e->HoldBuffer = true;
 	e->BufferIsStdbuf = true;
 	e->Size = buf.getSize(); // update size in case group changed on disk between calls
@@ -41,8 +41,10 @@
 // sort order lists in C4Components.h accordingly, and enforce a reading order for that
 // component.
 //
-// Maybe some day, someone will write a C4Group-implementation that is probably capable of
-// random access...
+// Indexed groups (C4GroupFileVer2Indexed) are capable of random access: They are not
+// wrapped into a zlib-stream as a whole. Instead, each entry may be compressed on its own,
+// so seeking to an entry is cheap and only the entry itself has to be unpacked. Use
+// c4group -c to convert between both formats.
 #ifdef _DEBUG
 extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_DISABLE_REWINDWARN ++iC4GroupRewindFilePtrNoWarn;
@@ -52,7 +54,7 @@ extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_ENABLE_REWINDWARN ;
 #endif
 
-const int C4GroupFileVer1=1, C4GroupFileVer2=2;
+const int C4GroupFileVer1=1, C4GroupFileVer2=2, C4GroupFileVer2Indexed=3;
 
 const int C4GroupMaxError = 100;
 
@@ -91,13 +93,15 @@ struct C4GroupHeader
 struct C4GroupEntryCore
 {
 	char FileName[260] = { 0 };
-	int32_t Packed = 0, ChildGroup = 0;
-	int32_t Size = 0, reserved1 = 0, Offset = 0;
+	int32_t Packed = 0, ChildGroup = 0; // Packed: entry is deflated (indexed groups only)
+	int32_t Size = 0, PackedSize = 0, Offset = 0;
 	int32_t reserved2 = 0;
 	char reserved3 = '\0';
 	unsigned int reserved4 = 0;
 	char Executable = '\0';
 	BYTE fbuf[26] = { 0 };
+
+	int32_t GetStoredSize() const { return Packed ? PackedSize : Size; }
 };
 
 #pragma pack (pop)
@@ -174,6 +178,7 @@ public:
 	               size_t *ipSize=nullptr, int iAppendZeros=0);
 	bool LoadEntry(const char *szEntryName, StdBuf * Buf);
 	bool LoadEntry(const StdStrBuf & name, StdBuf * Buf) { return LoadEntry(name.getData(), Buf); }
+	bool LoadEntryView(const char *szEntryName, StdBuf * Buf); // read-only, valid while the group (and its mothers) are open
 	bool LoadEntryString(const char *szEntryName, StdStrBuf * Buf);
 	bool LoadEntryString(const StdStrBuf & name, StdStrBuf * Buf) { return LoadEntryString(name.getData(), Buf); }
 	bool FindEntry(const char *szWildCard,
@@ -203,6 +208,7 @@ public:
 	}
 	bool Read(void *pBuffer, size_t iSize) override;
 	bool Advance(int iOffset) override;
+	bool ReadView(StdBuf &Buf, size_t iSize) override;
 	void SetStdOutput(bool fStatus);
 	void ResetSearch(bool reload_contents=false); // reset search pointer so calls to FindNextEntry find first entry again. if reload_contents is set, the file list for directories is also refreshed.
 	const char *GetError();
@@ -216,8 +222,11 @@ public:
 	C4Group *GetMother();
 	bool IsPacked() const;
 	bool HasPackedMother() const;
+	bool IsIndexed() const;
+	bool SetIndexed(bool fIndexed, bool fRecursive=false); // change format; the group is rewritten on Close
 	bool SetNoSort(bool fNoSort);
 	int PreCacheEntries(const char *szSearchPattern, bool cache_previous=false); // pre-load entries to memory. return number of loaded entries.
+	bool CanPreCacheConcurrently(); // whether PreCacheEntries may run in another thread while other groups are used (folders and indexed groups). call before starting that thread.
 
 	const C4GroupHeader &GetHeader() const;
 	const C4GroupEntry *GetFirstEntry() const;
@@ -241,10 +250,16 @@ private:
 	              bool fDeleteOnDisk = false,
 	              bool fHoldBuffer = false,
 	              bool fExecutable = false,
-	              bool fBufferIsStdbuf = false);
+	              bool fBufferIsStdbuf = false,
+	              long packedsize = 0);
 	bool AddEntryOnDisk(const char *szFilename, const char *szAddAs=nullptr, bool fMove=false);
 	bool SetFilePtr2Entry(const char *szName, bool NeedsToBeAGroup = false);
-	bool AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &stdfile);
+	bool AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &stdfile, bool fKeepPacked = false);
+	bool InflateEntry(C4GroupEntry *centry);
+	bool ReadEntryData(C4GroupEntry *centry, StdBuf &Data);
+	bool DeflateEntry(const StdBuf &Data, StdBuf &Packed);
+	bool IsSeekable() const;
+	const BYTE *MapData(size_t &iSize);
 	C4GroupEntry *SearchNextEntry(const char *szName);
 	C4GroupEntry *GetNextFolderEntry();
 	uint32_t CalcCRC32(C4GroupEntry *pEntry);
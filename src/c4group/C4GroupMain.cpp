@@ -78,6 +78,8 @@ void DisplayGroup(const C4Group &grp, const char *filter = nullptr)
 			entry->Size);
 		if (entry->ChildGroup != 0)
 			printf(" (Group)");
+		if (entry->Packed != 0)
+			printf(" (%u Bytes compressed)", entry->PackedSize);
 		if (entry->Executable != 0)
 			printf(" (Executable)");
 		printf("\n");
@@ -103,6 +105,7 @@ void PrintGroupInternals(C4Group &grp, int indent_level = 0)
 		printf("%*s  Packed: %d\n", indent, "", p->Packed);
 		printf("%*s  ChildGroup: %d\n", indent, "", p->ChildGroup);
 		printf("%*s  Size: %d\n", indent, "", p->Size);
+		printf("%*s  PackedSize: %d\n", indent, "", p->PackedSize);
 		printf("%*s  Offset: %d\n", indent, "", p->Offset);
 		printf("%*s  Executable: %d\n", indent, "", p->Executable);
 		if (p->ChildGroup != 0)
@@ -326,6 +329,20 @@ bool ProcessGroup(const char *FilenamePar)
 					case 'z':
 						PrintGroupInternals(hGroup);
 						break;
+						// Convert format
+					case 'c':
+						if ((iArg + 1 >= argc) || (!SEqual(argv[iArg + 1], "indexed") && !SEqual(argv[iArg + 1], "classic")))
+						{
+							fprintf(stderr, "Conversion failed: expected indexed or classic\n");
+						}
+						else
+						{
+							LogF("Converting to %s format...", argv[iArg + 1]);
+							if (!hGroup.SetIndexed(SEqual(argv[iArg + 1], "indexed"), true))
+								fprintf(stderr, "Conversion failed: %s\n", hGroup.GetError());
+							iArg++;
+						}
+						break;
 						// Undefined
 					default:
 						fprintf(stderr, "Unknown command: %s\n", argv[iArg]);
@@ -537,6 +554,7 @@ int main(int argc, char *argv[])
 		printf("          -y [ppid] Apply update (waiting for ppid to terminate first)\n");
 		printf("          -g [source] [target] [title] Make update\n");
 		printf("          -s Sort\n");
+		printf("          -c [indexed|classic] Convert format (indexed groups allow random access)\n");
 		printf("\n");
 		printf("Options:  -v Verbose -r Recursive\n");
 		printf("          -i Register shell -u Unregister shell\n");
@@ -32,6 +32,9 @@ public:
 	virtual bool Advance(int iOffset) = 0;
 	// Get size. compatible with c4group!
 	virtual size_t AccessedEntrySize() const = 0;
+	// Read without copying if the stream supports it. Buf then references read-only data that
+	// stays valid as long as the stream is open. Otherwise, Buf receives a copy.
+	virtual bool ReadView(StdBuf &Buf, size_t iSize) { Buf.New(iSize); return Read(Buf.getMData(), iSize); }
 	virtual ~CStdStream() = default;
 };
 
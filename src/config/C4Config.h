@@ -47,6 +47,7 @@ public:
 	int32_t DefRec;
 	int32_t MMTimer;  // use multimedia-timers
 	int32_t ScrollSmooth; // view movement smoothing
+	int32_t WorkerThreads; // threads helping with parallel simulation steps; -1 for one less than the number of cores
 	int32_t ConfigResetSafety; // safety value: If this value is screwed, the config got corrupted and must be reset
 	// Determined at run-time
 	StdCopyStrBuf ExePath;
@@ -806,7 +806,11 @@ void C4ControlSyncCheck::Execute() const
 		::Network.LeagueNotifyDisconnect(C4ClientIDHost, C4LDR_Desync);
 		// Deactivate / end
 		if (::Control.isReplay())
+		{
+			if (::Control.GetPlayback())
+				::Control.GetPlayback()->BenchmarkFailure("Synchronization loss");
 			Game.DoGameOver();
+		}
 		else if (::Control.isNetwork())
 		{
 			Game.RoundResults.EvaluateNetwork(C4RoundResults::NR_NetError, "Network: Synchronization loss!");
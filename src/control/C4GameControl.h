@@ -99,6 +99,7 @@ public:
 	bool isCtrlHost() const { return fHost; }
 	bool isRecord() const { return !! pRecord; }
 	C4Record * GetRecord() { return pRecord; }
+	C4Playback * GetPlayback() { return pPlayback; }
 	int32_t  ClientID() const { return iClientID; }
 	bool SyncMode() const { return eMode != CM_Local || pRecord; }
 
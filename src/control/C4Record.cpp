@@ -839,9 +839,10 @@ void C4Playback::Strip()
 
 bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 {
-	// still playbacking?
-	if (currChunk == chunks.end()) return false;
+	// still playbacking? The end chunk has been consumed already once the game reached it.
 	if (Finished) { Finish(); return false; }
+	if (currChunk == chunks.end()) return false;
+	if (fBenchmark) BenchmarkFrame(iFrame);
 	if (Config.General.DebugRec)
 	{
 		if (DebugRec.firstPkt())
@@ -893,7 +894,12 @@ void C4Playback::Finish()
 {
 	Clear();
 	// finished playback: end game
-	if (Console.Active)
+	if (fBenchmark)
+	{
+		// benchmark playback: report and quit
+		Game.FinishBenchmark();
+	}
+	else if (Console.Active)
 	{
 		++Game.HaltCount;
 		Console.UpdateHaltCtrls(!!Game.HaltCount);
@@ -1102,6 +1108,69 @@ void C4Playback::DebugRecError(const char *szError)
 {
 	LogF("Playback error: %s", szError);
 	BREAKPOINT_HERE;
+	BenchmarkFailure(szError);
+}
+
+void C4Playback::StartBenchmark()
+{
+	fBenchmark = true;
+	fBenchmarkFailed = false;
+	tBenchmarkLastFrame = std::chrono::steady_clock::time_point();
+	tBenchmarkTotal = 0;
+	tBenchmarkWorst = 0;
+	iBenchmarkWorstFrame = iBenchmarkFrames = 0;
+	std::fill_n(BenchmarkHistogram, BenchmarkBuckets, 0u);
+}
+
+void C4Playback::BenchmarkFrame(int iFrame)
+{
+	// time since the control of the previous frame was executed
+	auto tNow = std::chrono::steady_clock::now();
+	bool fFirstFrame = (tBenchmarkLastFrame == std::chrono::steady_clock::time_point());
+	auto tFrame = tNow - tBenchmarkLastFrame;
+	tBenchmarkLastFrame = tNow;
+	if (fFirstFrame) return;
+	uint32_t tTime = std::chrono::duration_cast<std::chrono::microseconds>(tFrame).count();
+	++iBenchmarkFrames;
+	tBenchmarkTotal += tTime;
+	if (tTime > tBenchmarkWorst)
+	{
+		tBenchmarkWorst = tTime;
+		iBenchmarkWorstFrame = iFrame - 1;
+	}
+	int iBucket = 0;
+	for (uint32_t tBucketMax = 1000; iBucket < BenchmarkBuckets - 1 && tTime >= tBucketMax; tBucketMax *= 2)
+		++iBucket;
+	++BenchmarkHistogram[iBucket];
+}
+
+void C4Playback::BenchmarkFailure(const char *szReason)
+{
+	if (!fBenchmark || fBenchmarkFailed) return;
+	fBenchmarkFailed = true;
+	LogFatal(FormatString("Benchmark: Replay diverged in frame %d: %s", Game.FrameCounter, szReason).getData());
+	// no point in measuring a desynced game any further
+	Finished = true;
+}
+
+StdStrBuf C4Playback::GetBenchmarkJSON() const
+{
+	StdStrBuf Result;
+	Result.Format(R"({"result":"%s","frames":%d,"time_us":%llu,"avg_us":%.2f,"worst_us":%u,"worst_frame":%d,"histogram":[)",
+	              fBenchmarkFailed ? "desync" : "ok", iBenchmarkFrames,
+	              static_cast<unsigned long long>(tBenchmarkTotal),
+	              iBenchmarkFrames ? double(tBenchmarkTotal) / iBenchmarkFrames : 0.0,
+	              tBenchmarkWorst, iBenchmarkWorstFrame);
+	for (int i = 0; i < BenchmarkBuckets; ++i)
+	{
+		if (i) Result.AppendChar(',');
+		if (i < BenchmarkBuckets - 1)
+			Result.AppendFormat(R"({"max_ms":%d,"frames":%u})", 1 << i, BenchmarkHistogram[i]);
+		else
+			Result.AppendFormat(R"({"max_ms":null,"frames":%u})", BenchmarkHistogram[i]);
+	}
+	Result.Append("]}");
+	return Result;
 }
 
 bool C4Playback::StreamToRecord(const char *szStream, StdStrBuf *pRecordFile)
@@ -23,6 +23,8 @@ class C4Record;
 #include "c4group/C4Group.h"
 #include "control/C4Control.h"
 
+#include <chrono>
+
 extern int DoNoDebugRec; // debugrec disable counter in C4Record.cpp
 
 #define DEBUGREC_OFF ++DoNoDebugRec;
@@ -295,6 +297,17 @@ private:
 	uint32_t iLastSequentialFrame; // frame number of last chunk read
 	void Finish(); // end playback
 	C4PacketList DebugRec;
+
+	// benchmark playback: replay at full speed and record the time spent per frame
+	static const int BenchmarkBuckets = 10; // frame time histogram: <1ms, <2ms, <4ms, ... , >=256ms
+	bool fBenchmark{false};
+	bool fBenchmarkFailed{false};
+	std::chrono::steady_clock::time_point tBenchmarkLastFrame;
+	uint64_t tBenchmarkTotal{0}; // microseconds
+	uint32_t tBenchmarkWorst{0}; // microseconds
+	int32_t iBenchmarkWorstFrame{0}, iBenchmarkFrames{0};
+	uint32_t BenchmarkHistogram[BenchmarkBuckets];
+	void BenchmarkFrame(int iFrame);
 public:
 	C4Playback(); // constructor; init playback
 	~C4Playback(); // destructor; deinit playback
@@ -312,6 +325,11 @@ public:
 	void Clear();
 	void Check(C4RecordChunkType eType, const uint8_t *pData, int iSize); // compare with debugrec
 	void DebugRecError(const char *szError);
+	void StartBenchmark();
+	void BenchmarkFailure(const char *szReason); // sync check or debugrec diverged
+	bool IsBenchmark() const { return fBenchmark; }
+	bool IsBenchmarkFailed() const { return fBenchmarkFailed; }
+	StdStrBuf GetBenchmarkJSON() const;
 	static bool StreamToRecord(const char *szStream, StdStrBuf *pRecord);
 };
 
@@ -39,6 +39,7 @@
 #include "network/C4Network2.h"
 #include "network/C4Network2IRC.h"
 #include "platform/C4GamePadCon.h"
+#include "platform/C4ThreadPool.h"
 
 #include <getopt.h>
 
@@ -128,6 +129,9 @@ bool C4Application::DoInit(int argc, char * argv[])
 	// Open additional logs that depend on command line
 	OpenExtraLogs();
 
+	// Worker threads for parallel simulation steps
+	ThreadPool.SetWorkerCount(Config.General.WorkerThreads);
+
 	// Init external language packs
 	Languages.Init();
 	// Load language string table
@@ -233,6 +237,8 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 			{"startup", required_argument, nullptr, 's'},
 			{"stream", required_argument, nullptr, 'e'},
 			{"recdump", required_argument, nullptr, 'R'},
+			{"benchmark", required_argument, nullptr, 'B'},
+			{"benchmarkfile", required_argument, nullptr, 'F'},
 			{"comment", required_argument, nullptr, 'm'},
 			{"pass", required_argument, nullptr, 'p'},
 			{"udpport", required_argument, nullptr, 'u'},
@@ -248,6 +254,7 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 
 			{"lobby", optional_argument, nullptr, 'l'},
 
+			{"benchmarkreplay", no_argument, &Game.BenchmarkReplay, 1},
 			{"debug-opengl", no_argument, &Config.Graphics.DebugOpenGL, 1},
 			{"config", required_argument, nullptr, 0},
 			{nullptr, 0, nullptr, 0}
@@ -328,6 +335,9 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 		case 'R': Game.RecordDumpFile.Copy(optarg); break;
 		// record stream
 		case 'e': Game.RecordStream.Copy(optarg); break;
+		// headless benchmark run
+		case 'B': Game.BenchmarkFrames = std::max(atoi(optarg), 0); break;
+		case 'F': Game.BenchmarkFile.Copy(optarg); break;
 		// startup start screen
 		case 's': C4Startup::SetStartScreen(optarg); break;
 		// additional read-only data path
@@ -463,8 +473,8 @@ void C4Application::ParseCommandLine(int argc, char * argv[])
 	// record?
 	Game.Record = Game.Record || (Config.Network.LeagueServerSignUp && Game.NetworkActive);
 
-	// startup dialog required?
-	QuitAfterGame = !isEditor && Game.HasScenario();
+	// startup dialog required? (benchmark runs are one-shot)
+	QuitAfterGame = (!isEditor || Game.BenchmarkFrames || Game.BenchmarkReplay) && Game.HasScenario();
 }
 
 void C4Application::ApplyResolutionConstraints()
@@ -584,6 +594,8 @@ void C4Application::Clear()
 	}
 	// quit irc
 	IRCClient.Close();
+	// stop worker threads
+	ThreadPool.SetWorkerCount(0);
 	// close system group (System.ocg)
 	SystemGroup.Close();
 	// Log
@@ -522,6 +522,9 @@ bool C4Game::Init()
 	// Notify editor
 	Console.InitGame();
 
+	// Headless benchmark run?
+	StartBenchmark();
+
 	return true;
 }
 
@@ -555,6 +558,7 @@ void C4Game::Clear()
 	// stop statistics
 	pNetworkStatistics.reset();
 	C4AulProfiler::Abort();
+	AulSampler.Stop();
 
 	// next mission (shoud have been transferred to C4Application now if next mission was desired)
 	NextMission.Clear(); NextMissionText.Clear(); NextMissionDesc.Clear();
@@ -738,7 +742,7 @@ bool C4Game::Execute() // Returns true if the game is over
 		AddDbgRec(RCT_DbgFrame, &FrameCounter, sizeof(int32_t));
 
 	// allow the particle system to execute the next frame BEFORE the other game stuff is calculated since it will run in parallel to the main thread
-	Particles.CalculateNextStep();
+	EXEC_S(     Particles.CalculateNextStep();    , DynPartStat )
 
 	// Game
 
@@ -773,6 +777,10 @@ bool C4Game::Execute() // Returns true if the game is over
 		C4ST_RESETPART
 	}
 
+	// benchmark done?
+	if (BenchmarkRunning && BenchmarkFrames && FrameCounter - BenchmarkStartFrame >= BenchmarkFrames)
+		FinishBenchmark();
+
 	if (Config.General.DebugRec)
 	{
 		AddDbgRec(RCT_Block, "eGame", 6);
@@ -782,6 +790,72 @@ bool C4Game::Execute() // Returns true if the game is over
 	return true;
 }
 
+void C4Game::StartBenchmark()
+{
+	if (!BenchmarkFrames && !BenchmarkReplay) return;
+	if (BenchmarkReplay)
+	{
+		if (!Control.GetPlayback())
+		{
+			LogFatal("Benchmark: --benchmarkreplay needs a record to play back");
+			fQuitWithError = true;
+			Application.QuitGame();
+			return;
+		}
+		Control.GetPlayback()->StartBenchmark();
+		Log("Benchmark: Playing back record at full speed");
+	}
+	if (BenchmarkFrames)
+		LogF("Benchmark: Running %d frames at full speed", BenchmarkFrames);
+	// no throttling by the game timer; skip drawing wherever possible
+	FullSpeed = true;
+	FrameSkip = 500;
+	// measure the frames from here on only
+	C4Stat::getMainStat()->Reset();
+	C4Stat::getMainStat()->Enable(true);
+	BenchmarkRunning = true;
+	BenchmarkStartFrame = FrameCounter;
+	BenchmarkStartTime = C4TimeMilliseconds::Now();
+	Application.NextTick();
+}
+
+bool C4Game::FinishBenchmark()
+{
+	if (!BenchmarkRunning) return false;
+	BenchmarkRunning = false;
+	int32_t iFrames = FrameCounter - BenchmarkStartFrame;
+	uint32_t tTime = C4TimeMilliseconds::Now() - BenchmarkStartTime;
+	double dFPS = tTime ? double(iFrames) * 1000 / tTime : 0.0;
+	// compose result
+	StdStrBuf Scenario(ScenarioFilename);
+	Scenario.EscapeString();
+	StdStrBuf Result;
+	Result.Format(R"({"engine":"%s","scenario":"%s","frames":%d,"time_ms":%u,"fps":%.2f,"stats":%s)",
+	              C4VERSION, Scenario.getData(), iFrames, tTime, dFPS,
+	              C4Stat::getMainStat()->ToJSON().getData());
+	C4Playback *pPlayback = Control.GetPlayback();
+	bool fFailed = pPlayback && pPlayback->IsBenchmarkFailed();
+	if (pPlayback && pPlayback->IsBenchmark())
+		Result.AppendFormat(R"(,"replay":%s)", pPlayback->GetBenchmarkJSON().getData());
+	Result.Append("}\n");
+#ifndef STAT
+	C4Stat::getMainStat()->Enable(false);
+#endif
+	LogF("Benchmark: %d frames in %u ms (%.2f FPS)", iFrames, tTime, dFPS);
+	// write result
+	const char *szFilename = BenchmarkFile.getLength() ? BenchmarkFile.getData() : C4CFN_Benchmark;
+	bool fSuccess = Result.SaveToFile(szFilename);
+	if (fSuccess)
+		LogF("Benchmark: Result written to %s", szFilename);
+	else
+		LogF("Benchmark: Could not write result to %s", szFilename);
+	// a diverged replay fails the run
+	if (fFailed || !fSuccess) fQuitWithError = true;
+	// done
+	Application.QuitGame();
+	return fSuccess && !fFailed;
+}
+
 void C4Game::InitFullscreenComponents(bool fRunning)
 {
 	// It can happen that this is called before graphics are loaded due to
@@ -2375,6 +2449,9 @@ bool C4Game::InitGameFinal(InitMode init_mode)
 
 bool C4Game::InitScriptEngine()
 {
+	// keep generated byte code in the user path to speed up the next start
+	ScriptEngine.SetCodeCache(Config.AtUserDataPath(C4CFN_ScriptCache), C4VERSION " " C4REVISION " " C4REVISION_TS);
+
 	// engine functions
 	InitCoreFunctionMap(&ScriptEngine);
 	InitObjectFunctionMap(&ScriptEngine);
@@ -26,6 +26,7 @@
 #include "landscape/C4PathFinder.h"
 #include "landscape/C4Scenario.h"
 #include "landscape/C4TransferZone.h"
+#include "platform/C4TimeMilliseconds.h"
 
 class C4ScriptGuiWindow;
 
@@ -124,6 +125,10 @@ public:
 	bool Record;
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
+	int32_t BenchmarkFrames{0}; // if nonzero, run this many frames at full speed, write timings and quit
+	int BenchmarkReplay{0}; // if set, play back the given record at full speed until its end, write timings and quit
+	StdStrBuf BenchmarkFile;
+	bool BenchmarkRunning{false}; int32_t BenchmarkStartFrame{0}; C4TimeMilliseconds BenchmarkStartTime;
 	StdStrBuf TempScenarioFile;
 	bool fPreinited{false}; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -162,6 +167,8 @@ public:
 	void SetScenarioFilename(const char*);
 	bool HasScenario() { return *DirectJoinAddress || *ScenarioFilename || RecordStream.getSize(); }
 	bool Execute();
+	void StartBenchmark();
+	bool FinishBenchmark();
 	C4Player *JoinPlayer(const char *szFilename, int32_t iAtClient, const char *szAtClientName, C4PlayerInfo *pInfo);
 	void OnPlayerJoinFinished();
 	bool DoGameOver();
@@ -311,7 +311,7 @@ static C4Value FnObjectCount(C4PropList * _this, C4Value *pPars)
 	if (!pFO)
 		throw C4AulExecError("ObjectCount: No valid search criterions supplied");
 	// Search
-	int32_t iCnt = pFO->Count(::Objects, ::Objects.Sectors);
+	int32_t iCnt = ::FindObjectCache.Count(*pFO, ::Objects, ::Objects.Sectors);
 	// Free
 	delete pFO;
 	// Return
@@ -328,7 +328,7 @@ static C4Value FnFindObject(C4PropList * _this, C4Value *pPars)
 	if (!pFO)
 		throw C4AulExecError("FindObject: No valid search criterions supplied");
 	// Search
-	C4Object *pObj = pFO->Find(::Objects, ::Objects.Sectors);
+	C4Object *pObj = ::FindObjectCache.Find(*pFO, ::Objects, ::Objects.Sectors);
 	// Free
 	delete pFO;
 	// Return
@@ -345,7 +345,7 @@ static C4Value FnFindObjects(C4PropList * _this, C4Value *pPars)
 	if (!pFO)
 		throw C4AulExecError("FindObjects: No valid search criterions supplied");
 	// Search
-	C4ValueArray *pResult = pFO->FindMany(::Objects, ::Objects.Sectors);
+	C4ValueArray *pResult = ::FindObjectCache.FindMany(*pFO, ::Objects, ::Objects.Sectors);
 	// Free
 	delete pFO;
 	// Return
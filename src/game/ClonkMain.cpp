@@ -99,6 +99,7 @@ int WINAPI WinMain (HINSTANCE hInst,
 		delete[] *it;
 	argv.clear();
 	// Return exit code
+	if (Game.fQuitWithError) return C4XRV_Failure;
 	if (!Game.GameOver) return C4XRV_Aborted;
 	return C4XRV_Completed;
 }
@@ -243,6 +244,7 @@ int main (int argc, char * argv[])
 	Application.Clear();
 	if (Application.restartAtEnd) restart(argv);
 	// Return exit code
+	if (Game.fQuitWithError) return C4XRV_Failure;
 	if (!Game.GameOver) return C4XRV_Aborted;
 	return C4XRV_Completed;
 }
@@ -149,16 +149,12 @@ bool C4Surface::Read(CStdStream &hGroup, const char * extension, int iFlags)
 
 bool C4Surface::ReadPNG(CStdStream &hGroup, int iFlags)
 {
-	// create mem block
-	int iSize=hGroup.AccessedEntrySize();
-	BYTE *pData=new BYTE[iSize];
-	// load file into mem
-	hGroup.Read((void *) pData, iSize);
+	// get file data (in place if the stream supports it)
+	StdBuf Data;
+	if (!hGroup.ReadView(Data, hGroup.AccessedEntrySize())) return false;
 	// load as png file
 	CPNGFile png;
-	bool fSuccess=png.Load(pData, iSize);
-	// free data
-	delete [] pData;
+	bool fSuccess=png.Load(getBufPtr<BYTE>(Data), Data.getSize());
 	// abort if loading wasn't successful
 	if (!fSuccess) return false;
 	// create surface(s) - do not create an 8bit-buffer!
@@ -150,7 +150,7 @@ void CPNGFile::Clear()
 	if (fp) { fclose(fp); fp=nullptr; }
 }
 
-bool CPNGFile::Load(unsigned char *pFile, int iSize)
+bool CPNGFile::Load(const unsigned char *pFile, int iSize)
 {
 	// clear any previously loaded file
 	Clear();
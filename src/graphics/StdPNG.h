@@ -23,13 +23,13 @@
 class CPNGFile
 {
 private:
-	BYTE *pFile;      // loaded file in mem
+	const BYTE *pFile; // loaded file in mem
 	bool fpFileOwned; // whether file ptr was allocated by this class
 	int iFileSize;    // size of file in mem
 	int iPixSize;     // size of one pixel in image data mem
 	FILE *fp;         // opened file for writing
 
-	BYTE *pFilePtr;   // current pos in file
+	const BYTE *pFilePtr; // current pos in file
 
 	bool fWriteMode;              // if set, the following png-structs are write structs
 	png_structp png_ptr;          // png main struct
@@ -50,7 +50,7 @@ public:
 	void ClearPngStructs();                       // clear internal png structs (png_tr, info_ptr etc.);
 	void Default();                               // zero fields
 	void Clear();                                 // clear loaded file
-	bool Load(BYTE *pFile, int iSize);            // load from file that is completely in mem
+	bool Load(const BYTE *pFile, int iSize);      // load from file that is completely in mem
 	DWORD GetPix(int iX, int iY);                 // get pixel value (rgba) - note that NO BOUNDS CHECKS ARE DONE due to performance reasons!
 	// Use ONLY for PNG_COLOR_TYPE_RGB_ALPHA!
 	uint32_t * GetRow(int iY)
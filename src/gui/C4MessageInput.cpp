@@ -28,6 +28,7 @@
 #include "object/C4Object.h"
 #include "player/C4Player.h"
 #include "player/C4PlayerList.h"
+#include "script/C4AulExec.h"
 
 // --------------------------------------------------
 // C4ChatInputDialog
@@ -571,6 +572,8 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 			LogF("/nodebug - %s", LoadResStr("IDS_TEXT_PREVENTDEBUGMODEINTHISROU"));
 			LogF("/script [script] - %s", LoadResStr("IDS_TEXT_EXECUTEASCRIPTCOMMAND"));
 			LogF("/screenshot [zoom] - %s", LoadResStr("IDS_TEXT_SAFEZOOMEDFULLSCREENSHOT"));
+			LogF("/profile start [interval] - %s", LoadResStr("IDS_TEXT_STARTSAMPLINGSCRIPTPROFILER"));
+			LogF("/profile stop [filename] - %s", LoadResStr("IDS_TEXT_STOPSAMPLINGSCRIPTPROFILER"));
 		}
 		LogF("/kick [client] - %s", LoadResStr("IDS_TEXT_KICKTHESPECIFIEDCLIENT"));
 		LogF("/observer [client] - %s", LoadResStr("IDS_TEXT_SETTHESPECIFIEDCLIENTTOOB"));
@@ -769,6 +772,38 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		return true;
 	}
 
+	// sampling script profiler. Local only, so it does not need to go through control.
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (!Game.IsRunning) return false;
+		if (SEqual2(pCmdPar, "start"))
+		{
+			// sample interval in microseconds
+			int32_t iInterval = atoi(pCmdPar + 5);
+			if (iInterval <= 0) iInterval = 1000;
+			AulSampler.Start(iInterval);
+			LogF("Script profiler: sampling every %d us.", (int) iInterval);
+			return true;
+		}
+		if (SEqual2(pCmdPar, "stop"))
+		{
+			if (!AulSampler.IsRunning()) return false;
+			AulSampler.Stop();
+			const char *szFilename = pCmdPar + 4;
+			while (*szFilename == ' ') ++szFilename;
+			StdCopyStrBuf sFilename(*szFilename ? szFilename : Config.AtUserDataPath("ScriptProfile.txt"));
+			if (!AulSampler.Save(sFilename.getData()))
+			{
+				LogF("Script profiler: could not write %s.", sFilename.getData());
+				return false;
+			}
+			LogF("Script profiler: %u samples written to %s.", AulSampler.GetSampleCount(), sFilename.getData());
+			return true;
+		}
+		Log("Syntax: /profile start [interval in microseconds] or /profile stop [filename]");
+		return false;
+	}
+
 	// add to TODO list
 	if (SEqual(szCmdName, "todo"))
 	{
@@ -62,6 +62,9 @@ struct C4Landscape::P
 	bool Pix2Light[C4M_MaxTexIndex];
 	int32_t PixCntPitch = 0;
 	std::vector<uint8_t> PixCnt;
+	uint64_t ChangeStamp = 0, GlobalChangeStamp = 0; // NoSave //
+	std::vector<uint64_t> ChangeStamps; // last change per pixel count cell - NoSave //
+	std::vector<uint64_t> ColumnChangeStamps; // last change per column of pixel count cells - NoSave //
 	std::array<C4Rect, C4LS_MaxRelights> Relights;
 	mutable std::array<std::unique_ptr<uint8_t[]>, C4M_MaxTexIndex> BridgeMatConversion; // NoSave //
 
@@ -73,6 +76,11 @@ struct C4Landscape::P
 
 	bool NoScan = false; // ExecuteScan() disabled
 	int32_t ScanX = 0, ScanSpeed = 2; // SyncClearance-NoSave //
+	std::vector<uint64_t> ScanStamps; // per column: ChangeStamp of the last scan that converted nothing, 0 if the column needs a scan - NoSave //
+	std::vector<int32_t> ScanReaches; // per column: rightmost column that scan looked at - NoSave //
+	int32_t ScanReach = 0; // rightmost column looked at by the current column scan - NoSave //
+	int32_t ScanTemperature = 0; // temperature the conversions below were determined for - NoSave //
+	std::vector<uint8_t> ScanConversions; // per material: which temperature conversions are active - NoSave //
 	C4Real Gravity = DefaultGravAccel;
 	uint32_t Modulation = 0;    // landscape blit modulation; 0 means normal
 	int32_t MapSeed = 0; // random seed for MapToLandscape
@@ -101,6 +109,11 @@ struct C4Landscape::P
 	bool CreateMapS2(C4Group &ScenFile, CSurface8*& sfcMap, CSurface8*& sfcMapBkg); // create map by def file
 	bool Mat2Pal(); // assign material colors to landscape palette
 	void UpdatePixCnt(const C4Landscape *, const C4Rect &Rect, bool fCheck = false);
+	void MarkChange(int32_t x, int32_t y) { if (!ChangeStamps.empty()) ChangeStamps[(y / 15) + (x / 17) * PixCntPitch] = ColumnChangeStamps[x / 17] = ++ChangeStamp; }
+	void MarkChange(const C4Rect &Rect);
+	void MarkGlobalChange() { GlobalChangeStamp = ++ChangeStamp; }
+	bool ColumnsChangedSince(int32_t x1, int32_t x2, uint64_t iStamp) const; // any change in columns x1 to x2 (inclusive) after the given stamp?
+	bool UpdateScanConversions(); // returns whether any temperature conversion is active
 	void UpdateMatCnt(const C4Landscape *, C4Rect Rect, bool fPlus);
 	void PrepareChange(const C4Landscape *d, const C4Rect &BoundingBox);
 	void FinishChange(C4Landscape *d, C4Rect BoundingBox);
@@ -213,47 +226,92 @@ void C4Landscape::Execute()
 }
 
 
+bool C4Landscape::P::UpdateScanConversions()
+{
+	// conversions only depend on the temperature through these comparisons, so
+	// a column that was static since its last scan only needs another one if they change
+	const int32_t iTemperature = ::Weather.GetTemperature();
+	bool fActive = false;
+	if (iTemperature != ScanTemperature || ScanConversions.size() != static_cast<size_t>(::MaterialMap.Num))
+	{
+		std::vector<uint8_t> Conversions(::MaterialMap.Num);
+		for (int32_t mat = 0; mat < ::MaterialMap.Num; mat++)
+		{
+			const C4Material &Mat = ::MaterialMap.Map[mat];
+			Conversions[mat] = (Mat.BelowTempConvertTo && iTemperature < Mat.BelowTempConvert)
+			                 | ((Mat.AboveTempConvertTo && iTemperature > Mat.AboveTempConvert) << 1);
+		}
+		if (Conversions != ScanConversions)
+		{
+			ScanConversions.swap(Conversions);
+			std::fill(ScanStamps.begin(), ScanStamps.end(), 0);
+		}
+		ScanTemperature = iTemperature;
+	}
+	// Check: Scan needed?
+	for (int32_t mat = 0; mat < ::MaterialMap.Num; mat++)
+		if (MatCount[mat] && ScanConversions[mat])
+			fActive = true;
+	return fActive;
+}
+
+bool C4Landscape::P::ColumnsChangedSince(int32_t x1, int32_t x2, uint64_t iStamp) const
+{
+	if (GlobalChangeStamp > iStamp) return true;
+	for (int32_t x = std::max<int32_t>(0, x1 / 17); x <= std::min<int32_t>(ColumnChangeStamps.size() - 1, x2 / 17); x++)
+		if (ColumnChangeStamps[x] > iStamp)
+			return true;
+	return false;
+}
+
 void C4Landscape::P::ExecuteScan(C4Landscape *d)
 {
 	int32_t cy, mat;
 
 	// Check: Scan needed?
-	const int32_t iTemperature = ::Weather.GetTemperature();
-	for (mat = 0; mat < ::MaterialMap.Num; mat++)
-		if (MatCount[mat])
-		{
-			if (::MaterialMap.Map[mat].BelowTempConvertTo &&
-				iTemperature < ::MaterialMap.Map[mat].BelowTempConvert)
-				break;
-			else if (::MaterialMap.Map[mat].AboveTempConvertTo &&
-				iTemperature > ::MaterialMap.Map[mat].AboveTempConvert)
-				break;
-		}
-	if (mat >= ::MaterialMap.Num)
+	if (!UpdateScanConversions())
 		return;
 
 	if (DEBUGREC_MATSCAN && Config.General.DebugRec)
 		AddDbgRec(RCT_MatScan, &ScanX, sizeof(ScanX));
 
+	if (ScanStamps.size() != static_cast<size_t>(Width))
+	{
+		ScanStamps.assign(Width, 0);
+		ScanReaches.assign(Width, 0);
+	}
+
 	for (int32_t cnt = 0; cnt < ScanSpeed; cnt++)
 	{
 
-		// Scan landscape column: sectors down
-		int32_t last_mat = -1;
-		for (cy = 0; cy < Height; cy++)
+		// Skip columns where nothing the last scan looked at has changed since. It did not convert
+		// anything then, and it would come to the same result now.
+		if (!ScanStamps[ScanX] || ColumnsChangedSince(ScanX - 1, ScanReaches[ScanX], ScanStamps[ScanX]))
 		{
-			mat = d->_GetMat(ScanX, cy);
-			// material change?
-			if (last_mat != mat)
+			uint64_t iStampBefore = ChangeStamp;
+			ScanReach = ScanX;
+
+			// Scan landscape column: sectors down
+			int32_t last_mat = -1;
+			for (cy = 0; cy < Height; cy++)
 			{
-				// upwards
-				if (last_mat != -1)
-					DoScan(d, ScanX, cy - 1, last_mat, 1);
-				// downwards
-				if (mat != -1)
-					cy += DoScan(d, ScanX, cy, mat, 0);
+				mat = d->_GetMat(ScanX, cy);
+				// material change?
+				if (last_mat != mat)
+				{
+					// upwards
+					if (last_mat != -1)
+						DoScan(d, ScanX, cy - 1, last_mat, 1);
+					// downwards
+					if (mat != -1)
+						cy += DoScan(d, ScanX, cy, mat, 0);
+				}
+				last_mat = mat;
 			}
-			last_mat = mat;
+
+			// Remember static columns
+			ScanStamps[ScanX] = (ChangeStamp == iStampBefore) ? ChangeStamp : 0;
+			ScanReaches[ScanX] = ScanReach;
 		}
 
 		// Scan advance & rewind
@@ -309,6 +367,7 @@ int32_t C4Landscape::P::DoScan(C4Landscape *d, int32_t cx, int32_t cy, int32_t m
 		{
 			// one step right
 			cxs++;
+			ScanReach = std::max(ScanReach, cxs);
 			if (d->_GetMat(cxs, cys) == mat)
 			{
 				// search surface
@@ -806,6 +865,7 @@ bool C4Landscape::_SetPix2(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 	if (bgPix == Transparent) bgPix = p->Surface8Bkg->_GetPix(x, y);
 	// check pixel
 	if (fgPix == opix && bgPix == p->Surface8Bkg->_GetPix(x, y)) return true;
+	p->MarkChange(x, y);
 	// count pixels
 	if (p->Pix2Dens[fgPix])
 	{
@@ -883,6 +943,7 @@ void C4Landscape::_SetPix2Tmp(int32_t x, int32_t y, BYTE fgPix, BYTE bgPix)
 {
 	// set 8bpp-surface only!
 	assert(x >= 0 && y >= 0 && x < GetWidth() && y < GetHeight());
+	p->MarkChange(x, y);
 	if (fgPix != Transparent) p->Surface8->SetPix(x, y, fgPix);
 	if (bgPix != Transparent) p->Surface8Bkg->SetPix(x, y, bgPix);
 }
@@ -1378,6 +1439,12 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky, bool fClearRender
 	// clear pixel count
 	p->PixCnt.clear();
 	p->PixCntPitch = 0;
+	p->ChangeStamps.clear();
+	p->ColumnChangeStamps.clear();
+	p->ScanStamps.clear();
+	p->ScanReaches.clear();
+	p->ScanConversions.clear();
+	p->MarkGlobalChange();
 	// clear bridge material conversion temp buffers
 	for (auto &conv : p->BridgeMatConversion)
 		conv.reset();
@@ -1583,6 +1650,9 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	int32_t PixCntWidth = (GetWidth() + 16) / 17;
 	p->PixCntPitch = (GetHeight() + 14) / 15;
 	p->PixCnt.resize(PixCntWidth * p->PixCntPitch);
+	p->ChangeStamps.resize(PixCntWidth * p->PixCntPitch);
+	p->ColumnChangeStamps.resize(PixCntWidth);
+	p->MarkGlobalChange();
 
 	// map to big surface and sectionize it
 	// (not for shaders though - they require continous textures)
@@ -3339,7 +3409,14 @@ void C4Landscape::FindMatTop(int32_t mat, int32_t &x, int32_t &y, bool distant_f
 
 	do
 	{
-		// Catch most common case: Walk upwards until material changes
+		// Catch most common case: Walk upwards until material changes.
+		// Mass movers do this through whole lakes, so go through the pixels directly where possible.
+		if (Inside<int32_t>(x, 0, p->Width - 1) && Inside<int32_t>(y, 1, p->Height))
+		{
+			const int32_t iPitch = p->Surface8->Pitch;
+			const BYTE *pPix = p->Surface8->Bits + (y - 1) * iPitch + x;
+			while (y > 0 && p->Pix2Mat[*pPix] == mat) { --y; pPix -= iPitch; }
+		}
 		while (GetMat(x, y - 1) == mat) --y;
 
 		// Find upwards slide
@@ -3937,6 +4014,7 @@ void C4Landscape::P::FinishChange(C4Landscape *d, C4Rect BoundingBox)
 	}
 	C4SolidMask::CheckConsistency();
 	UpdatePixCnt(d, BoundingBox);
+	MarkChange(BoundingBox);
 	// update FoW
 	if (pFoW)
 	{
@@ -4225,6 +4303,7 @@ void C4Landscape::UpdatePixMaps()
 	for (i = 0; i < C4M_MaxTexIndex; i++) p->Pix2Place[i] = MatValid(p->Pix2Mat[i]) ? ::MaterialMap.Map[p->Pix2Mat[i]].Placement : 0;
 	for (i = 0; i < C4M_MaxTexIndex; i++) p->Pix2Light[i] = MatValid(p->Pix2Mat[i]) && (::MaterialMap.Map[p->Pix2Mat[i]].Light>0);
 	p->Pix2Place[0] = 0;
+	p->MarkGlobalChange();
 	// clear bridge mat conversion buffers
 	std::fill(p->BridgeMatConversion.begin(), p->BridgeMatConversion.end(), nullptr);
 }
@@ -4249,6 +4328,34 @@ bool C4Landscape::P::Mat2Pal()
 }
 
 
+void C4Landscape::P::MarkChange(const C4Rect &Rect)
+{
+	int32_t PixCntWidth = ColumnChangeStamps.size();
+	++ChangeStamp;
+	for (int32_t x = std::max<int32_t>(0, Rect.x / 17); x < std::min<int32_t>(PixCntWidth, (Rect.x + Rect.Wdt + 16) / 17); x++)
+	{
+		for (int32_t y = std::max<int32_t>(0, Rect.y / 15); y < std::min<int32_t>(PixCntPitch, (Rect.y + Rect.Hgt + 14) / 15); y++)
+			ChangeStamps[x * PixCntPitch + y] = ChangeStamp;
+		ColumnChangeStamps[x] = ChangeStamp;
+	}
+}
+
+uint64_t C4Landscape::GetChangeStamp() const
+{
+	return p->ChangeStamp;
+}
+
+bool C4Landscape::HasChangedSince(const C4Rect &Rect, uint64_t iStamp) const
+{
+	if (p->GlobalChangeStamp > iStamp) return true;
+	int32_t PixCntWidth = (p->Width + 16) / 17;
+	for (int32_t x = std::max<int32_t>(0, Rect.x / 17); x < std::min<int32_t>(PixCntWidth, (Rect.x + Rect.Wdt + 16) / 17); x++)
+		for (int32_t y = std::max<int32_t>(0, Rect.y / 15); y < std::min<int32_t>(p->PixCntPitch, (Rect.y + Rect.Hgt + 14) / 15); y++)
+			if (p->ChangeStamps[x * p->PixCntPitch + y] > iStamp)
+				return true;
+	return false;
+}
+
 void C4Landscape::P::UpdatePixCnt(const C4Landscape *d, const C4Rect &Rect, bool fCheck)
 {
 	int32_t PixCntWidth = (Width + 16) / 17;
@@ -127,6 +127,8 @@ public:
 	int32_t GetPixMat(BYTE byPix) const;
 	int32_t GetPixDensity(BYTE byPix) const;
 	bool _PathFree(int32_t x, int32_t y, int32_t x2, int32_t y2) const; // quickly checks wether there *might* be pixel in the path.
+	uint64_t GetChangeStamp() const; // increased by every change to landscape pixels or pixel maps
+	bool HasChangedSince(const C4Rect &Rect, uint64_t iStamp) const; // checks wether anything in the (pixel count cells of the) rect has changed after the given stamp
 	int32_t GetMatHeight(int32_t x, int32_t y, int32_t iYDir, int32_t iMat, int32_t iMax) const;
 
 	int32_t AreaSolidCount(int32_t x, int32_t y, int32_t wdt, int32_t hgt) const;
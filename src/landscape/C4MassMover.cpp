@@ -49,48 +49,65 @@ C4MassMoverSet::~C4MassMoverSet()
 
 void C4MassMoverSet::Clear()
 {
+	Chunks.clear();
+	Size=0;
+}
 
+void C4MassMoverSet::Grow(int32_t iNewSize)
+{
+	// Add blocks as needed. Blocks never move, so movers may create others while being executed.
+	while (iNewSize > int32_t(Chunks.size()) * C4MassMoverChunk)
+	{
+		Chunks.emplace_back(new C4MassMover[C4MassMoverChunk]);
+		for (int32_t cnt = 0; cnt<C4MassMoverChunk; cnt++) Chunks.back()[cnt].Mat=MNone;
+	}
+	Size=std::max(Size,iNewSize);
 }
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
 	// Init counts
 	Count=0;
-	// Execute & count
+	// Execute & count. Movers created at or above the current slot are not executed until the next pass.
 	for (int32_t speed = 2; speed>0; speed--)
-	{
-		cmm = &(Set[C4MassMoverChunk-1]);
-		for (int32_t cnt = 0; cnt<C4MassMoverChunk; cnt++,cmm--)
-			if (cmm->Mat!=MNone)
-				{ Count++; cmm->Execute(); }
-	}
+		for (int32_t cnt = Size-1; cnt>=0; cnt--)
+		{
+			C4MassMover &cmm = Get(cnt);
+			if (cmm.Mat!=MNone)
+				{ Count++; cmm.Execute(); }
+		}
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
 	if (Config.General.DebugRec)
 	{
 		C4RCMassMover rc;
 		rc.x=x; rc.y=y;
 		AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 	}
+	// Search for a free slot after the previous one. Slots beyond Size are all free,
+	// so they are simply added until the first block is used up.
 	int32_t cptr=CreatePtr;
 	do
 	{
 		cptr++;
-		if (cptr>=C4MassMoverChunk) cptr=0;
-		if (Set[cptr].Mat==MNone)
+		if (cptr>=Size)
 		{
-			if (!Set[cptr].Init(x,y)) return false;
-			CreatePtr=cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
+			if (cptr<C4MassMoverChunk) Grow(cptr+1);
+			else cptr=0;
 		}
+		if (cptr<Size && Get(cptr).Mat==MNone) break;
 	}
 	while (cptr!=CreatePtr);
-	return false;
+	// All taken: add a slot
+	if (cptr<Size && Get(cptr).Mat!=MNone)
+		Grow((cptr=Size)+1);
+	C4MassMover &cmm = Get(cptr);
+	if (!cmm.Init(x,y)) return false;
+	CreatePtr=cptr;
+	if (fExecute) cmm.Execute();
+	return true;
 }
 
 void C4MassMoverSet::Draw()
@@ -182,8 +199,8 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt=0; cnt<C4MassMoverChunk; cnt++) Set[cnt].Mat=MNone;
+	Chunks.clear();
+	Size=0;
 	Count=0;
 	CreatePtr=0;
 }
@@ -195,8 +212,8 @@ bool C4MassMoverSet::Save(C4Group &hGroup)
 	Consolidate();
 	// Recount
 	Count=0;
-	for (cnt=0; cnt<C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat!=MNone)
+	for (cnt=0; cnt<Size; cnt++)
+		if (Get(cnt).Mat!=MNone)
 			Count++;
 	// All empty: delete component
 	if (!Count)
@@ -205,7 +222,13 @@ bool C4MassMoverSet::Save(C4Group &hGroup)
 		return true;
 	}
 	// Save set
-	if (!hGroup.Add(C4CFN_MassMover,Set,Count*sizeof(C4MassMover)))
+	StdBuf Buf;
+	Buf.New(Count*sizeof(C4MassMover));
+	C4MassMover *pSave = getMBufPtr<C4MassMover>(Buf);
+	for (cnt=0; cnt<Size; cnt++)
+		if (Get(cnt).Mat!=MNone)
+			*pSave++=Get(cnt);
+	if (!hGroup.Add(C4CFN_MassMover,Buf,false,true))
 		return false;
 	// Success
 	return true;
@@ -219,8 +242,13 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 	if (!hGroup.AccessEntry(C4CFN_MassMover,&iBinSize)) return false;
 	if ((iBinSize % iMoverSize)!=0) return false;
 	// load new
+	StdBuf Buf;
+	Buf.New(iBinSize);
+	if (!hGroup.Read(Buf.getMData(),iBinSize)) return false;
 	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set,iBinSize)) return false;
+	Grow(Count);
+	for (int32_t cnt=0; cnt<Count; cnt++)
+		Get(cnt)=getBufPtr<C4MassMover>(Buf)[cnt];
 	return true;
 }
 
@@ -228,10 +256,10 @@ void C4MassMoverSet::Consolidate()
 {
 	// Consolidate set
 	int32_t iSpot,iPtr,iConsolidated;
-	for (iSpot=-1,iPtr=0,iConsolidated=0; iPtr<C4MassMoverChunk; iPtr++)
+	for (iSpot=-1,iPtr=0,iConsolidated=0; iPtr<Size; iPtr++)
 	{
 		// Empty: set new spot if needed
-		if (Set[iPtr].Mat==MNone)
+		if (Get(iPtr).Mat==MNone)
 		{
 			if (iSpot==-1) iSpot=iPtr;
 		}
@@ -239,17 +267,19 @@ void C4MassMoverSet::Consolidate()
 		else if (iSpot!=-1)
 		{
 			// Move to spot
-			Set[iSpot]=Set[iPtr];
-			Set[iPtr].Mat=MNone;
+			Get(iSpot)=Get(iPtr);
+			Get(iPtr).Mat=MNone;
 			iConsolidated++;
 			// Advance empty spot (as far as ptr)
 			for (; iSpot<iPtr; iSpot++)
-				if (Set[iSpot].Mat==MNone)
+				if (Get(iSpot).Mat==MNone)
 					break;
 			// No empty spot below ptr
 			if (iSpot==iPtr) iSpot=-1;
 		}
 	}
+	// Drop free slots at the end
+	while (Size && Get(Size-1).Mat==MNone) Size--;
 	// Reset create ptr
 	CreatePtr=0;
 }
@@ -264,7 +294,8 @@ void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 	Clear();
 	Count=rSet.Count;
 	CreatePtr=rSet.CreatePtr;
-	for (int32_t cnt=0; cnt<C4MassMoverChunk; cnt++) Set[cnt]=rSet.Set[cnt];
+	Grow(rSet.Size);
+	for (int32_t cnt=0; cnt<Size; cnt++) Get(cnt)=rSet.Get(cnt);
 }
 
 C4MassMoverSet MassMover;
@@ -20,6 +20,8 @@
 #ifndef INC_C4MassMover
 #define INC_C4MassMover
 
+// Mass movers are allocated in blocks of this size. Slots of the first block are
+// reused in a ring; further blocks are only added while all slots are taken.
 const int32_t C4MassMoverChunk = 10000;
 
 class C4MassMover
@@ -43,7 +45,10 @@ public:
 	int32_t Count;
 	int32_t CreatePtr;
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	std::vector<std::unique_ptr<C4MassMover[]>> Chunks;
+	int32_t Size; // number of slots in use; all slots from here on are free
+	C4MassMover &Get(int32_t i) const { return Chunks[i / C4MassMoverChunk][i % C4MassMoverChunk]; }
+	void Grow(int32_t iNewSize);
 public:
 	void Copy(C4MassMoverSet &rSet);
 	void Synchronize();
@@ -27,10 +27,32 @@
 #include "landscape/C4Weather.h"
 #include "lib/C4Random.h"
 #include "lib/StdColors.h"
+#include "platform/C4ThreadPool.h"
 
 static const C4Real WindDrift_Factor = itofix(1, 800);
 
-bool C4PXS::Execute()
+// Gravity; in the air also wind and some random drift. The randomness comes from the
+// seed rather than the synchronized RNG, so the result does not depend on the order of execution.
+static void ApplyForces(int32_t Mat, int32_t iX, int32_t iY, uint64_t iSeed, C4Real &xdir, C4Real &ydir)
+{
+	// Gravity
+	ydir+=GravAccel;
+
+	if (GBackDensity(iX, iY + 1) < ::MaterialMap.Map[Mat].Density)
+	{
+		// Air speed: Wind plus some random
+		int32_t iWind = Weather.GetWind(iX, iY);
+		C4Real txdir = itofix(iWind, 15) + C4REAL256(SeededRandom(iSeed, 1200) - 600);
+		C4Real tydir = C4REAL256(SeededRandom(iSeed | 1, 1200) - 600);
+
+		// Air friction, based on WindDrift. MaxSpeed is ignored.
+		int32_t iWindDrift = std::max(::MaterialMap.Map[Mat].WindDrift - 20, 0);
+		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
+		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
+	}
+}
+
+bool C4PXS::Execute(uint64_t iSeed)
 {
 	if (DEBUGREC_PXS && Config.General.DebugRec)
 	{
@@ -56,21 +78,8 @@ bool C4PXS::Execute()
 	if (pReact && (*pReact->pFunc)(pReact, iX,iY, iX,iY, xdir,ydir, Mat,inmat, meePXSPos, nullptr))
 		{ Deactivate(); return false; }
 
-	// Gravity
-	ydir+=GravAccel;
-
-	if (GBackDensity(iX, iY + 1) < ::MaterialMap.Map[Mat].Density)
-	{
-		// Air speed: Wind plus some random
-		int32_t iWind = Weather.GetWind(iX, iY);
-		C4Real txdir = itofix(iWind, 15) + C4REAL256(Random(1200) - 600);
-		C4Real tydir = C4REAL256(Random(1200) - 600);
-
-		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = std::max(::MaterialMap.Map[Mat].WindDrift - 20, 0);
-		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
-		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
-	}
+	// Gravity, wind and drift
+	ApplyForces(Mat, iX, iY, iSeed, xdir, ydir);
 
 	C4Real ctcox = x + xdir;
 	C4Real ctcoy = y + ydir;
@@ -158,41 +167,203 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count=0;
+	iExecuteCount=0;
+	fExecuting=false;
 }
 
 void C4PXSSystem::Clear()
 {
 	Count=0;
+	Chunks.clear();
+	Keys.clear();
+}
+
+C4PXS C4PXSSystem::Get(size_t i) const
+{
+	const C4PXSChunk &Chunk = GetChunk(i);
+	size_t k = i % PXSChunkSize;
+	C4PXS pxs;
+	pxs.Mat = Chunk.Mat[k];
+	pxs.x = Chunk.x[k]; pxs.y = Chunk.y[k];
+	pxs.xdir = Chunk.xdir[k]; pxs.ydir = Chunk.ydir[k];
+	return pxs;
+}
+
+void C4PXSSystem::Set(size_t i, const C4PXS &rPXS)
+{
+	C4PXSChunk &Chunk = GetChunk(i);
+	size_t k = i % PXSChunkSize;
+	Chunk.Mat[k] = rPXS.Mat;
+	Chunk.x[k] = rPXS.x; Chunk.y[k] = rPXS.y;
+	Chunk.xdir[k] = rPXS.xdir; Chunk.ydir[k] = rPXS.ydir;
 }
 
-C4PXS* C4PXSSystem::New()
+void C4PXSSystem::Remove(size_t i)
 {
-	if (Count < PXSMax)
-		return &PXS[Count++];
-	return nullptr;
+	// replace by last one
+	if (i != --Count) Set(i, Get(Count));
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Real ix, C4Real iy, C4Real ixdir, C4Real iydir)
 {
-	C4PXS *pxp;
 	if (!MatValid(mat)) return false;
-	if (!(pxp=New())) return false;
-	pxp->Mat=mat;
-	pxp->x=ix; pxp->y=iy;
-	pxp->xdir=ixdir; pxp->ydir=iydir;
+	if (Count >= PXSMax) return false;
+	// grow
+	if (Count == Chunks.size() * PXSChunkSize)
+		Chunks.emplace_back(new C4PXSChunk);
+	C4PXS pxs;
+	pxs.Mat=mat;
+	pxs.x=ix; pxs.y=iy;
+	pxs.xdir=ixdir; pxs.ydir=iydir;
+	Set(Count++, pxs);
 	return true;
 }
 
+void C4PXSSystem::Predict(size_t iChunk, uint64_t iFrameSeed)
+{
+	// Does what C4PXS::Execute would do for all PXS of a chunk, split into passes over
+	// the arrays. Anything involving material reactions is left to Execute.
+	const C4PXSChunk &Chunk = *Chunks[iChunk];
+	size_t iFirst = iChunk * PXSChunkSize, iCount = std::min(Count - iFirst, PXSChunkSize);
+	int32_t iWdt = ::Landscape.GetWidth(), iHgt = ::Landscape.GetHeight();
+	C4Real Gravity = GravAccel;
+	int32_t PosX[PXSChunkSize], PosY[PXSChunkSize], WindDrift[PXSChunkSize];
+	C4Real TargetXDir[PXSChunkSize], TargetYDir[PXSChunkSize];
+	C4Real *pXDir = &Predicted.xdir[iFirst], *pYDir = &Predicted.ydir[iFirst];
+	C4Real *pX = &Predicted.x[iFirst], *pY = &Predicted.y[iFirst];
+	uint8_t *pResult = &Predicted.Result[iFirst];
+	// Landscape lookups at the current position
+	for (size_t k = 0; k < iCount; ++k)
+	{
+		int32_t Mat = Chunk.Mat[k];
+		C4Real x = Chunk.x[k], y = Chunk.y[k];
+		pResult[k] = PR_Move;
+		WindDrift[k] = 0;
+		TargetXDir[k] = TargetYDir[k] = Fix0;
+		PosX[k] = fixtoi(x); PosY[k] = fixtoi(y);
+		// Safety; out of bounds
+		if (!MatValid(Mat) || (x<0) || (x>=iWdt) || (y<-10) || (y>=iHgt))
+			{ pResult[k] = PR_Remove; Predicted.Area[iFirst + k].Default(); continue; }
+		// Material conversion
+		if (::MaterialMap.GetReactionUnsafe(Mat, GBackMat(PosX[k], PosY[k])))
+			{ pResult[k] = PR_None; continue; }
+		// Air speed: Wind plus some random
+		if (GBackDensity(PosX[k], PosY[k] + 1) < ::MaterialMap.Map[Mat].Density)
+		{
+			uint64_t iSeed = iFrameSeed | (uint64_t(iFirst + k) << 1);
+			TargetXDir[k] = itofix(Weather.GetWind(PosX[k], PosY[k]), 15) + C4REAL256(SeededRandom(iSeed, 1200) - 600);
+			TargetYDir[k] = C4REAL256(SeededRandom(iSeed | 1, 1200) - 600);
+			WindDrift[k] = std::max(::MaterialMap.Map[Mat].WindDrift - 20, 0);
+		}
+	}
+	// Gravity and air friction (no change for WindDrift 0)
+	for (size_t k = 0; k < iCount; ++k)
+	{
+		C4Real xdir = Chunk.xdir[k], ydir = Chunk.ydir[k] + Gravity;
+		xdir += ((TargetXDir[k] - xdir) * WindDrift[k]) * WindDrift_Factor;
+		ydir += ((TargetYDir[k] - ydir) * WindDrift[k]) * WindDrift_Factor;
+		pXDir[k] = xdir; pYDir[k] = ydir;
+		pX[k] = Chunk.x[k] + xdir; pY[k] = Chunk.y[k] + ydir;
+	}
+	// Quick path check
+	std::vector<size_t> Blocked;
+	for (size_t k = 0; k < iCount; ++k)
+	{
+		if (pResult[k] != PR_Move) continue;
+		int32_t iX = PosX[k], iY = PosY[k], iToX = fixtoi(pX[k]), iToY = fixtoi(pY[k]);
+		C4Rect &rArea = Predicted.Area[iFirst + k];
+		rArea.x = std::min(iX, iToX); rArea.Wdt = std::max(iX, iToX) - rArea.x + 1;
+		rArea.y = std::min(iY, iToY); rArea.Hgt = std::max(iY + 1, iToY) - rArea.y + 1;
+		if (!Inside<int32_t>(iToX, 0, iWdt-1) || !Inside<int32_t>(iToY, 0, iHgt-1) || !::Landscape._PathFree(iX, iY, iToX, iToY))
+			Blocked.push_back(k);
+	}
+	// Anything in the way of the others? Walk them top to bottom for cache locality.
+	std::sort(Blocked.begin(), Blocked.end(), [&PosX, &PosY](size_t a, size_t b)
+		{ return PosY[a] < PosY[b] || (PosY[a] == PosY[b] && PosX[a] < PosX[b]); });
+	for (size_t k : Blocked)
+	{
+		int32_t Mat = Chunk.Mat[k];
+		int32_t iX = PosX[k], iY = PosY[k], iToX = fixtoi(pX[k]), iToY = fixtoi(pY[k]);
+		do
+		{
+			iX += Sign(iToX - iX); iY += Sign(iToY - iY);
+			if (::MaterialMap.GetReactionUnsafe(Mat, GBackMat(iX, iY)))
+				{ pResult[k] = PR_None; break; }
+		}
+		while (iX != iToX || iY != iToY);
+	}
+}
+
 void C4PXSSystem::Execute()
 {
+	if (!Count) return;
+	// The random drift of all PXS in this frame derives from one synchronized random value
+	uint64_t iFrameSeed = uint64_t(Random(UINT32_MAX)) << 32;
+	// Keys are the initial indices. PXS created during the frame are numbered in order of creation.
+	// (ExecutePXS may be called by script during execution, so there might be an outer Execute.)
+	std::vector<uint32_t> NestedKeys;
+	bool fNested = fExecuting;
+	std::vector<uint32_t> &rKeys = fNested ? NestedKeys : Keys;
+	uint32_t iOwnExecuteCount = ++iExecuteCount;
+	fExecuting = true;
+	rKeys.resize(Count);
+	uint32_t iNextKey = 0;
+	for (uint32_t &iKey : rKeys) iKey = iNextKey++;
+	// Predict movement. This only reads from the landscape, so each prediction
+	// equals what Execute would do if nothing has changed since.
+	size_t iPredicted = 0;
+	uint64_t iLandscapeStamp = ::Landscape.GetChangeStamp();
+	C4Real Gravity = GravAccel;
+	int32_t iWind = ::Weather.Wind;
+	if (!fNested && !(DEBUGREC_PXS && Config.General.DebugRec))
+	{
+		iPredicted = Count;
+		Predicted.Result.resize(Count);
+		Predicted.x.resize(Count); Predicted.y.resize(Count);
+		Predicted.xdir.resize(Count); Predicted.ydir.resize(Count);
+		Predicted.Area.resize(Count);
+		ThreadPool.ParallelFor(Chunks.size(), 1, [this, iFrameSeed](size_t iBegin, size_t iEnd)
+		{
+			for (size_t iChunk = iBegin; iChunk < iEnd; ++iChunk)
+				Predict(iChunk, iFrameSeed);
+		});
+	}
+	// Apply in order. Predictions whose input has been changed by previous PXS (or the scripts
+	// they called) are discarded, so the result is the same as with plain serial execution.
 	for (size_t i = 0; i < Count; i++)
 	{
-		if (!PXS[i].Execute())
+		uint32_t iKey = rKeys[i];
+		bool fActive;
+		if (iKey < iPredicted && Predicted.Result[iKey] != PR_None && iExecuteCount == iOwnExecuteCount
+		    && GravAccel == Gravity && ::Weather.Wind == iWind && !::Landscape.HasChangedSince(Predicted.Area[iKey], iLandscapeStamp))
+		{
+			fActive = (Predicted.Result[iKey] == PR_Move);
+			if (fActive)
+			{
+				C4PXSChunk &Chunk = GetChunk(i);
+				size_t k = i % PXSChunkSize;
+				Chunk.x[k] = Predicted.x[iKey]; Chunk.y[k] = Predicted.y[iKey];
+				Chunk.xdir[k] = Predicted.xdir[iKey]; Chunk.ydir[k] = Predicted.ydir[iKey];
+			}
+		}
+		else
 		{
-			assert(PXS[i].Mat == MNone);
-			PXS[i--] = PXS[--Count];
+			C4PXS pxs = Get(i);
+			fActive = pxs.Execute(iFrameSeed | (uint64_t(iKey) << 1));
+			Set(i, pxs);
+		}
+		// new PXS from reactions
+		while (rKeys.size() < Count)
+			rKeys.push_back(iNextKey++);
+		if (!fActive)
+		{
+			Remove(i);
+			rKeys[i] = rKeys.back();
+			rKeys.pop_back();
+			--i;
 		}
 	}
+	fExecuting = fNested;
 }
 
 void C4PXSSystem::Draw(C4TargetFacet &cgo)
@@ -213,7 +384,8 @@ void C4PXSSystem::Draw(C4TargetFacet &cgo)
 	// First pass: draw simple PXS (lines/pixels)
 	for (size_t i = 0; i < Count; i++)
 	{
-		C4PXS *pxp = &PXS[i];
+		C4PXS pxs = Get(i);
+		const C4PXS *pxp = &pxs;
 		if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
 		{
 			C4Material *pMat = &::MaterialMap.Map[pxp->Mat];
@@ -341,8 +513,14 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 #endif
 	if (!hTempFile.Write(&iNumFormat, sizeof (iNumFormat)))
 		return false;
-	if (!hTempFile.Write(PXS, Count * sizeof(C4PXS)))
-		return false;
+	std::vector<C4PXS> Buffer(PXSChunkSize);
+	for (size_t i = 0; i < Count; i += PXSChunkSize)
+	{
+		size_t iNum = std::min(Count - i, PXSChunkSize);
+		for (size_t k = 0; k < iNum; ++k) Buffer[k] = Get(i + k);
+		if (!hTempFile.Write(&Buffer[0], iNum * sizeof(C4PXS)))
+			return false;
+	}
 
 	if (!hTempFile.Close())
 		return false;
@@ -375,23 +553,29 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	// calc chunk count
 	PXSNum = iBinSize / sizeof(C4PXS);
 	if (PXSNum > PXSMax) return false;
-	if (!hGroup.Read(PXS, iBinSize)) return false;
-	// count the PXS, Peter!
-	Count = PXSNum;
-	// convert num format, if neccessary
-	for (size_t i = 0; i < Count; i++)
+	std::vector<C4PXS> Buffer(PXSChunkSize);
+	for (size_t i = 0; i < PXSNum; i += PXSChunkSize)
 	{
-		C4PXS *pxp = &PXS[i];
-		if (pxp->Mat != MNone)
+		size_t iNum = std::min(PXSNum - i, PXSChunkSize);
+		if (!hGroup.Read(&Buffer[0], iNum * sizeof(C4PXS))) { Clear(); return false; }
+		Chunks.emplace_back(new C4PXSChunk);
+		for (size_t k = 0; k < iNum; ++k)
 		{
-			// convert number format
+			C4PXS *pxp = &Buffer[k];
+			if (pxp->Mat != MNone)
+			{
+				// convert number format
 #ifdef C4REAL_USE_FIXNUM
-			if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
+				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
 #else
-			if (iNumForm == 1) { FIXED_TO_FLOAT(&pxp->x); FIXED_TO_FLOAT(&pxp->y); FIXED_TO_FLOAT(&pxp->xdir); FIXED_TO_FLOAT(&pxp->ydir); }
+				if (iNumForm == 1) { FIXED_TO_FLOAT(&pxp->x); FIXED_TO_FLOAT(&pxp->y); FIXED_TO_FLOAT(&pxp->xdir); FIXED_TO_FLOAT(&pxp->ydir); }
 #endif
+			}
+			Set(i + k, *pxp);
 		}
 	}
+	// count the PXS, Peter!
+	Count = PXSNum;
 	return true;
 }
 
@@ -401,7 +585,7 @@ int32_t C4PXSSystem::GetCount(int32_t mat) const
 	int32_t result = 0;
 	for (size_t i = 0; i < Count; i++)
 	{
-		if (PXS[i].Mat == mat) ++result;
+		if (Get(i).Mat == mat) ++result;
 	}
 	return result;
 }
@@ -412,7 +596,8 @@ int32_t C4PXSSystem::GetCount(int32_t mat, int32_t x, int32_t y, int32_t wdt, in
 	int32_t result = 0;
 	for (size_t i = 0; i < Count; i++)
 	{
-		const C4PXS *pxp = &PXS[i];
+		C4PXS pxs = Get(i);
+		const C4PXS *pxp = &pxs;
 		if (pxp->Mat == mat || mat == MNone)
 			if (Inside(pxp->x, x, x + wdt - 1) && Inside(pxp->y, y, y + hgt - 1))
 				++result;
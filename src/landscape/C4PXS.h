@@ -21,7 +21,9 @@
 #define INC_C4PXS
 
 #include "landscape/C4Material.h"
+#include "lib/C4Rect.h"
 
+// A single PXS, as used for execution with material reactions and in savegames
 class C4PXS
 {
 	friend class C4PXSSystem;
@@ -29,11 +31,19 @@ protected:
 	int32_t Mat{MNone};
 	C4Real x{Fix0}, y{Fix0}, xdir{Fix0}, ydir{Fix0};
 protected:
-	bool Execute();
+	bool Execute(uint64_t iSeed);
 	void Deactivate();
 };
 
-const size_t PXSMax = 10000;
+const size_t PXSChunkSize = 1024; // PXS are allocated in blocks of this size
+const size_t PXSMax = 100000;
+
+// Storage of PXSChunkSize PXS in structure-of-arrays layout
+struct C4PXSChunk
+{
+	int32_t Mat[PXSChunkSize];
+	C4Real x[PXSChunkSize], y[PXSChunkSize], xdir[PXSChunkSize], ydir[PXSChunkSize];
+};
 
 class C4PXSSystem
 {
@@ -43,7 +53,24 @@ public:
 public:
 	size_t Count;
 protected:
-	C4PXS PXS[PXSMax];
+	std::vector<std::unique_ptr<C4PXSChunk>> Chunks;
+	// Keys identify PXS within the current frame and seed their random drift
+	std::vector<uint32_t> Keys;
+	// Movement in the current frame, computed ahead of the serial execution. Indexed by key.
+	enum PredictionResult : uint8_t { PR_None = 0, PR_Move, PR_Remove };
+	struct
+	{
+		std::vector<uint8_t> Result;
+		std::vector<C4Real> x, y, xdir, ydir;
+		std::vector<C4Rect> Area; // landscape area the movement depends on
+	} Predicted;
+	uint32_t iExecuteCount; // Execute calls so far, to detect nested execution
+	bool fExecuting;
+	C4PXSChunk &GetChunk(size_t i) const { return *Chunks[i / PXSChunkSize]; }
+	C4PXS Get(size_t i) const;
+	void Set(size_t i, const C4PXS &rPXS);
+	void Remove(size_t i);
+	void Predict(size_t iChunk, uint64_t iFrameSeed);
 public:
 	void Default();
 	void Clear();
@@ -56,8 +83,6 @@ public:
 	int32_t GetCount() const { return Count; } // count all PXS
 	int32_t GetCount(int32_t mat) const; // count PXS of given material
 	int32_t GetCount(int32_t mat, int32_t x, int32_t y, int32_t wdt, int32_t hgt) const; // count PXS of given material in given area. mat==-1 for all materials.
-protected:
-	C4PXS *New();
 };
 
 extern C4PXSSystem PXS;
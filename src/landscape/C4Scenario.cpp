@@ -218,6 +218,7 @@ void C4SGame::Default()
 	Rules.Clear();
 	FoWEnabled = true;
 	EvaluateOnAbort = false;
+	FindObjectCache = false;
 }
 
 void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
@@ -234,6 +235,7 @@ void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
 	pComp->Value(mkNamingAdapt(Rules,                                             "Rules",           C4IDList()));
 	pComp->Value(mkNamingAdapt(FoWEnabled,                                        "FoWEnabled",      true));
 	pComp->Value(mkNamingAdapt(EvaluateOnAbort,                                   "EvaluateOnAbort", false));
+	pComp->Value(mkNamingAdapt(FindObjectCache,                                   "FindObjectCache", false));
 }
 
 void C4SPlrStart::Default()
@@ -128,6 +128,8 @@ public:
 
 	bool EvaluateOnAbort;
 
+	bool FindObjectCache; // reuse results of identical searches within a frame
+
 public:
 	bool IsMelee();
 	void Default();
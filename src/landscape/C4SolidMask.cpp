@@ -491,8 +491,8 @@ CSurface8 *C4SolidMask::LoadMaskFromFile(class C4Group &hGroup, const char *szFi
 	// All pixels that are more than 50% transparent are not solid
 	CPNGFile png;
 	StdBuf png_buf;
-	if (!hGroup.LoadEntry(szFilename, &png_buf)) return nullptr; // error messages done by caller
-	if (!png.Load((BYTE*)png_buf.getMData(), png_buf.getSize())) return nullptr;
+	if (!hGroup.LoadEntryView(szFilename, &png_buf)) return nullptr; // error messages done by caller
+	if (!png.Load(getBufPtr<BYTE>(png_buf), png_buf.getSize())) return nullptr;
 	CSurface8 *result = new CSurface8(png.iWdt, png.iHgt);
 	for (size_t y=0u; y<png.iHgt; ++y)
 		for (size_t x=0u; x<png.iWdt; ++x)
@@ -65,6 +65,16 @@ void C4MainStat::UnRegStat(C4Stat* pStat)
 	}
 }
 
+void C4MainStat::Enable(bool fToEnabled)
+{
+	C4Stat::Enabled = fToEnabled;
+}
+
+bool C4MainStat::IsEnabled() const
+{
+	return C4Stat::Enabled;
+}
+
 void C4MainStat::Reset()
 {
 	for (C4Stat* pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
@@ -133,8 +143,8 @@ void C4MainStat::Show()
 		// output it!
 		if (pAkt->iCount)
 			LogSilentF("%s: n = %u, t = %u, td = %.2f",
-			           pAkt->strName, pAkt->iCount, pAkt->tTimeSum,
-			           double(pAkt->tTimeSum) / pAkt->iCount * 1000);
+			           pAkt->strName, pAkt->iCount, static_cast<unsigned int>(pAkt->tTimeSum / 1000),
+			           double(pAkt->tTimeSum) / pAkt->iCount);
 	}
 
 	// delete...
@@ -153,14 +163,42 @@ void C4MainStat::ShowPart(int FrameCounter)
 
 	// insert all stats
 	for (pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
-		LogSilentF("%s: n=%u, t=%u", pAkt->strName, pAkt->iCountPart, pAkt->tTimeSumPart);
+		LogSilentF("%s: n=%u, t=%u", pAkt->strName, pAkt->iCountPart, static_cast<unsigned int>(pAkt->tTimeSumPart / 1000));
 
 	// insert part stat end idtf
 	LogSilentF("** PartStat end\n");
 }
 
+StdStrBuf C4MainStat::ToJSON() const
+{
+	StdStrBuf Result;
+	Result = "[";
+	bool fFirst = true;
+	for (C4Stat* pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
+	{
+		if (!pAkt->iCount) continue;
+		if (!fFirst) Result.AppendChar(',');
+		fFirst = false;
+		StdStrBuf Name(pAkt->strName);
+		Name.EscapeString();
+		Result.AppendFormat(R"({"name":"%s","count":%u,"time_us":%llu,"avg_us":%.2f,"max_us":%llu})",
+		                    Name.getData(), pAkt->iCount,
+		                    static_cast<unsigned long long>(pAkt->tTimeSum),
+		                    double(pAkt->tTimeSum) / pAkt->iCount,
+		                    static_cast<unsigned long long>(pAkt->tTimeMax));
+	}
+	Result.AppendChar(']');
+	return Result;
+}
+
 // ** implemetation of C4Stat
 
+#ifdef STAT
+bool C4Stat::Enabled = true;
+#else
+bool C4Stat::Enabled = false;
+#endif
+
 C4Stat::C4Stat(const char* strnName)
 		: strName(strnName)
 {
@@ -178,6 +216,7 @@ void C4Stat::Reset()
 	iStartCalled = 0;
 
 	tTimeSum = 0;
+	tTimeMax = 0;
 	iCount = 0;
 
 	ResetPart();
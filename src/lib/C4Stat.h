@@ -17,6 +17,8 @@
 #ifndef INC_C4Stat
 #define INC_C4Stat
 
+#include <chrono>
+
 class C4Stat;
 
 // *** main statistic class
@@ -35,6 +37,13 @@ public:
 	void Reset();
 	void ResetPart();
 
+	// benchmark mode: statistics are collected in all builds while enabled
+	void Enable(bool fToEnabled);
+	bool IsEnabled() const;
+
+	// all statistics that have been started as a JSON array
+	StdStrBuf ToJSON() const;
+
 protected:
 	C4Stat* pFirst{nullptr};
 
@@ -56,8 +65,9 @@ public:
 
 	inline void Start()
 	{
+		if (!Enabled) return;
 		if (!iStartCalled)
-			tStartTime = C4TimeMilliseconds::Now();
+			tStartTime = std::chrono::steady_clock::now();
 		iCount ++;
 		iCountPart ++;
 		iStartCalled ++;
@@ -65,14 +75,16 @@ public:
 
 	inline void Stop()
 	{
+		if (!Enabled) return;
 		assert(iStartCalled);
 		iStartCalled --;
-		if (!iStartCalled && iCount >= 100)
+		if (!iStartCalled)
 		{
-			uint32_t tTime = C4TimeMilliseconds::Now() - tStartTime;
+			uint64_t tTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tStartTime).count();
 
 			tTimeSum += tTime;
 			tTimeSumPart += tTime;
+			if (tTime > tTimeMax) tTimeMax = tTime;
 		}
 	}
 
@@ -81,13 +93,16 @@ public:
 
 	static C4MainStat *getMainStat();
 
+	// set through C4MainStat::Enable; static so Start/Stop stay cheap
+	static bool Enabled;
+
 protected:
 
 	// used by C4MainStat
 	C4Stat* pNext;
 	C4Stat* pPrev;
 
-	C4TimeMilliseconds tStartTime;
+	std::chrono::steady_clock::time_point tStartTime;
 
 	// start-call depth
 	unsigned int iStartCalled;
@@ -95,16 +110,19 @@ protected:
 
 	// ** statistic data
 
-	// sum of times
-	uint32_t tTimeSum;
+	// sum of times (microseconds)
+	uint64_t tTimeSum;
+
+	// longest single measurement (microseconds)
+	uint64_t tTimeMax;
 
 	// number of starts called
 	unsigned int iCount;
 
 	// ** statistic data (partial stat)
 
-	// sum of times
-	uint32_t tTimeSumPart;
+	// sum of times (microseconds)
+	uint64_t tTimeSumPart;
 
 	// number of starts called
 	unsigned int iCountPart;
@@ -119,7 +137,9 @@ protected:
 };
 
 // *** some directives
-#ifdef STAT
+
+// Checkpoints are always compiled in, but only measure while the main
+// statistic is enabled (always with STAT, otherwise e.g. in benchmark mode)
 
 // used to create and start a new C4Stat object
 #define C4ST_STARTNEW(StatName, strName) static C4Stat StatName(strName); StatName.Start();
@@ -133,6 +153,8 @@ protected:
 // used to stop an existing C4Stat object
 #define C4ST_STOP(StatName) StatName.Stop();
 
+#ifdef STAT
+
 // shows the statistic (to log)
 #define C4ST_SHOWSTAT C4Stat::getMainStat()->Show();
 
@@ -147,10 +169,6 @@ protected:
 
 #else
 
-#define C4ST_STARTNEW(StatName, strName)
-#define C4ST_NEW(StatName, strName)
-#define C4ST_START(StatName)
-#define C4ST_STOP(StatName)
 #define C4ST_SHOWSTAT
 #define C4ST_SHOWPARTSTAT(FrameCounter)
 #define C4ST_RESET
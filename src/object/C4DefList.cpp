@@ -27,9 +27,34 @@
 #include "lib/StdMeshLoader.h"
 #include "object/C4Def.h"
 #include "platform/C4FileMonitor.h"
+#include "platform/C4ThreadPool.h"
 
 namespace
 {
+	// Files read by C4Def::Load, which are read ahead for sibling definitions
+	const char *C4DefList_PreCacheFiles = C4CFN_DefCore "|" C4CFN_ParticleCore "|Script*.c|C4Script*.c|StringTbl*.txt|"
+	                                      C4CFN_DefMaterials "|*.mesh|*.skeleton|*.xml|" C4CFN_ShaderFiles "|" C4CFN_ImageFiles "|"
+	                                      "ClonkNames*.txt|Rank*.txt";
+
+	// Reads the files of the given definition groups into memory in worker threads. All parsing
+	// stays on the main thread, because it registers IDs, strings, graphics and sounds globally.
+	void PreCacheDefs(std::list<C4Group> &Groups, DWORD dwLoadWhat)
+	{
+		std::vector<C4Group *> Readable;
+		for (C4Group &Group : Groups)
+			if (Group.CanPreCacheConcurrently())
+				Readable.push_back(&Group);
+		bool fSounds = !!(dwLoadWhat & C4D_Load_Sounds);
+		ThreadPool.ParallelFor(Readable.size(), 1, [&Readable, fSounds](size_t iBegin, size_t iEnd)
+		{
+			for (size_t i = iBegin; i < iEnd; ++i)
+			{
+				Readable[i]->PreCacheEntries(C4DefList_PreCacheFiles);
+				if (fSounds) Readable[i]->PreCacheEntries(C4CFN_SoundFiles);
+			}
+		});
+	}
+
 	class C4SkeletonManager : public StdMeshSkeletonLoader
 	{
 		StdMeshSkeleton* GetSkeletonByDefinition(const char* definition) const override
@@ -127,17 +152,36 @@ int32_t C4DefList::Load(C4Group &hGroup, DWORD dwLoadWhat,
 
 	// Load sub definitions
 	int i = 0;
+	auto LoadChild = [&](C4Group &hChild)
+	{
+		// Hack: Assume that there are sixteen sub definitions to avoid unnecessary I/O
+		int iSubMinProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * i) / 16);
+		int iSubMaxProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * (i + 1)) / 16);
+		++i;
+		iResult += Load(hChild,dwLoadWhat,szLanguage,pSoundSystem,fOverload,fSearchMessage,iSubMinProgress,iSubMaxProgress);
+		hChild.Close();
+	};
 	hGroup.ResetSearch();
-	while (hGroup.FindNextEntry(C4CFN_DefFiles,szEntryname))
-		if (hChild.OpenAsChild(&hGroup,szEntryname))
+	if (ThreadPool.IsParallel() && hGroup.CanPreCacheConcurrently())
+	{
+		// Children can be read independently: open all of them up front and read their files ahead
+		std::list<C4Group> Children;
+		while (hGroup.FindNextEntry(C4CFN_DefFiles,szEntryname))
 		{
-			// Hack: Assume that there are sixteen sub definitions to avoid unnecessary I/O
-			int iSubMinProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * i) / 16);
-			int iSubMaxProgress = std::min(iMaxProgress, iMinProgress + ((iMaxProgress - iMinProgress) * (i + 1)) / 16);
-			++i;
-			iResult += Load(hChild,dwLoadWhat,szLanguage,pSoundSystem,fOverload,fSearchMessage,iSubMinProgress,iSubMaxProgress);
-			hChild.Close();
+			Children.emplace_back();
+			if (!Children.back().OpenAsChild(&hGroup,szEntryname)) Children.pop_back();
 		}
+		PreCacheDefs(Children, dwLoadWhat);
+		for (; !Children.empty(); Children.pop_front())
+			LoadChild(Children.front());
+	}
+	else
+	{
+		// Classic packed groups are one stream, so open the children one after another
+		while (hGroup.FindNextEntry(C4CFN_DefFiles,szEntryname))
+			if (hChild.OpenAsChild(&hGroup,szEntryname))
+				LoadChild(hChild);
+	}
 
 	// load additional system scripts for def groups only
 	if (!fPrimaryDef && fLoadSysGroups) Game.LoadAdditionalSystemGroup(hGroup);
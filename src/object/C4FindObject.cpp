@@ -262,6 +262,28 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 		return 0;
 	if (IsEnsured())
 		return Objs.ObjectCount();
+	return CountIn(Objs);
+}
+
+C4Object *C4FindObject::Find(const C4ObjectList &Objs)
+{
+	// Trivial case
+	if (IsImpossible())
+		return nullptr;
+	return FindIn(Objs);
+}
+
+// return is to be freed by the caller
+C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
+{
+	// Trivial case
+	if (IsImpossible())
+		return new C4ValueArray();
+	return FindManyIn(Objs);
+}
+
+template <class ObjectRange> int32_t C4FindObject::CountIn(const ObjectRange &Objs)
+{
 	// Count
 	int32_t iCount = 0;
 	for (C4Object *obj : Objs)
@@ -270,11 +292,8 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs)
 	return iCount;
 }
 
-C4Object *C4FindObject::Find(const C4ObjectList &Objs)
+template <class ObjectRange> C4Object *C4FindObject::FindIn(const ObjectRange &Objs)
 {
-	// Trivial case
-	if (IsImpossible())
-		return nullptr;
 	// Search
 	// Double-check object status, as object might be deleted after Check()!
 	C4Object *pBestResult = nullptr;
@@ -293,12 +312,8 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs)
 	return pBestResult;
 }
 
-// return is to be freed by the caller
-C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
+template <class ObjectRange> C4ValueArray *C4FindObject::FindManyIn(const ObjectRange &Objs)
 {
-	// Trivial case
-	if (IsImpossible())
-		return new C4ValueArray();
 	// Set up array
 	C4ValueArray *pArray = new C4ValueArray(32);
 	int32_t iSize = 0;
@@ -322,6 +337,29 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs)
 	return pArray;
 }
 
+C4FindObject::SearchStrategy C4FindObject::PlanSearch(const C4LSectors &Sct)
+{
+	C4Rect *pBounds = GetBounds();
+	if (!pBounds)
+		return SS_MainList;
+	// Shapes may reach into other sectors than the position. The fine grid does not know about them.
+	if (UseShapes())
+		return SS_Sectors;
+	// Estimate the work of each strategy: Every object that is looked at, plus the overhead of starting
+	// a list. Sectors are walked via list iterators, which take a bit longer to set up.
+	int32_t iSectors, iObjects = Sct.GetObjectCount(*pBounds, &iSectors);
+	int32_t iCells = Sct.GetCellCount(*pBounds);
+	int32_t iCellObjects = std::min<int32_t>(iObjects, iObjects * iCells / std::max(iSectors * (C4LSectorWdt / C4LCellWdt) * (C4LSectorHgt / C4LCellHgt), 1));
+	int32_t iSectorCost = iObjects + iSectors * 4;
+	int32_t iCellCost = iCellObjects + iCells;
+	int32_t iMainListCost = Sct.ObjectCount;
+	if (iMainListCost < iSectorCost && iMainListCost < iCellCost)
+		return SS_MainList;
+	if (iCellCost < iSectorCost)
+		return SS_Cells;
+	return SS_Sectors;
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 {
 	// Trivial cases
@@ -331,8 +369,15 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		return Objs.ObjectCount();
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
-	if (!pBounds)
-		return Count(Objs);
+	SearchStrategy eStrategy = PlanSearch(Sct);
+	if (eStrategy == SS_MainList)
+		return CountIn(Objs);
+	else if (eStrategy == SS_Cells)
+	{
+		std::vector<C4Object *> Candidates;
+		Sct.GetCellObjects(*pBounds, Candidates);
+		return CountIn(Candidates);
+	}
 	else if (UseShapes())
 	{
 		// Get area
@@ -340,12 +385,12 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		C4ObjectList *pLst = Area.FirstObjectShapes(&pSct);
 		// Check if a single-sector check is enough
 		if (!Area.Next(pSct))
-			return Count(pSct->ObjectShapes);
+			return CountIn(pSct->ObjectShapes);
 		// Create marker, count over all areas
 		uint32_t iMarker = ::Objects.GetNextMarker();
 		int32_t iCount = 0;
 		for (; pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
-			for (C4Object *obj : Objs)
+			for (C4Object *obj : *pLst)
 				if (obj->Status)
 					if (obj->Marker != iMarker)
 					{
@@ -361,7 +406,7 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
 		int32_t iCount = 0;
 		for (C4ObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
-			iCount += Count(*pLst);
+			iCount += CountIn(*pLst);
 		return iCount;
 	}
 }
@@ -374,15 +419,22 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	C4Object *pBestResult = nullptr;
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
-	if (!pBounds)
-		return Find(Objs);
+	SearchStrategy eStrategy = PlanSearch(Sct);
+	if (eStrategy == SS_MainList)
+		return FindIn(Objs);
+	else if (eStrategy == SS_Cells)
+	{
+		std::vector<C4Object *> Candidates;
+		Sct.GetCellObjects(*pBounds, Candidates);
+		return FindIn(Candidates);
+	}
 	// Traverse areas, return first matching object w/o sort or best with sort
 	else if (UseShapes())
 	{
 		C4LArea Area(&::Objects.Sectors, *pBounds); C4LSector *pSct;
 		C4Object *pObj;
 		for (C4ObjectList *pLst=Area.FirstObjectShapes(&pSct); pLst; pLst=Area.NextObjectShapes(pLst, &pSct))
-			if ((pObj = Find(*pLst)))
+			if ((pObj = FindIn(*pLst)))
 			{
 				if (!pSort)
 					return pObj;
@@ -397,7 +449,7 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 		C4Object *pObj;
 		for (C4ObjectList *pLst=Area.FirstObjects(&pSct); pLst; pLst=Area.NextObjects(pLst, &pSct))
 		{
-			if ((pObj = Find(*pLst)))
+			if ((pObj = FindIn(*pLst)))
 			{
 				if (!pSort)
 					return pObj;
@@ -417,8 +469,15 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	if (IsImpossible())
 		return new C4ValueArray();
 	C4Rect *pBounds = GetBounds();
-	if (!pBounds)
-		return FindMany(Objs);
+	SearchStrategy eStrategy = PlanSearch(Sct);
+	if (eStrategy == SS_MainList)
+		return FindManyIn(Objs);
+	else if (eStrategy == SS_Cells)
+	{
+		std::vector<C4Object *> Candidates;
+		Sct.GetCellObjects(*pBounds, Candidates);
+		return FindManyIn(Candidates);
+	}
 	// Prepare for array that may be generated
 	C4ValueArray *pArray; int32_t iSize;
 	// Check shape lists?
@@ -429,7 +488,7 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		C4ObjectList *pLst = Area.FirstObjectShapes(&pSct);
 		// Check if a single-sector check is enough
 		if (!Area.Next(pSct))
-			return FindMany(pSct->ObjectShapes);
+			return FindManyIn(pSct->ObjectShapes);
 		// Set up array
 		pArray = new C4ValueArray(32); iSize = 0;
 		// Create marker, search all areas
@@ -846,6 +905,170 @@ bool C4FindObjectProperty::IsImpossible()
 }
 
 
+// *** Search keys
+
+bool C4FindObject::GetKey(int32_t iType, int32_t iCnt, C4FindObject **ppConds, C4FindObjectKey &rKey)
+{
+	// The order of conditions does not change the result, so sort them
+	std::vector<C4FindObjectKey> Keys(iCnt);
+	for (int32_t i = 0; i < iCnt; i++)
+		if (!ppConds[i]->GetKey(Keys[i]))
+			return false;
+	std::sort(Keys.begin(), Keys.end());
+	rKey.push_back(iType);
+	rKey.push_back(iCnt);
+	for (const C4FindObjectKey &rCondKey : Keys)
+	{
+		rKey.push_back(rCondKey.size());
+		rKey.insert(rKey.end(), rCondKey.begin(), rCondKey.end());
+	}
+	return true;
+}
+
+void C4FindObject::GetKey(const char *szString, C4FindObjectKey &rKey)
+{
+	if (!szString) { rKey.push_back(-1); return; }
+	size_t iLen = strlen(szString);
+	rKey.push_back(iLen);
+	rKey.insert(rKey.end(), szString, szString + iLen);
+}
+
+// Objects are identified by number, as another object might be created at the same address
+static intptr_t ObjectKey(C4Object *pObj) { return pObj ? pObj->Number : 0; }
+
+bool C4FindObjectNot::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4FO_Not);
+	return pCond->GetKey(rKey);
+}
+
+bool C4FindObjectAnd::GetKey(C4FindObjectKey &rKey) { return C4FindObject::GetKey(C4FO_And, iCnt, ppConds, rKey); }
+bool C4FindObjectOr::GetKey(C4FindObjectKey &rKey) { return C4FindObject::GetKey(C4FO_Or, iCnt, ppConds, rKey); }
+
+bool C4FindObjectExclude::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Exclude, ObjectKey(pExclude) });
+	return true;
+}
+
+bool C4FindObjectDef::GetKey(C4FindObjectKey &rKey)
+{
+	// Static prop lists such as definitions stay at their address for the whole game
+	if (!def) return false;
+	if (def->IsStatic())
+		rKey.insert(rKey.end(), { C4FO_ID, reinterpret_cast<intptr_t>(def) });
+	else if (def->IsNumbered())
+		rKey.insert(rKey.end(), { C4FO_ID, 0, def->GetPropListNumbered()->Number });
+	else
+		return false;
+	return true;
+}
+
+bool C4FindObjectInRect::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_InRect, rect.x, rect.y, rect.Wdt, rect.Hgt });
+	return true;
+}
+
+bool C4FindObjectAtPoint::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_AtPoint, bounds.x, bounds.y });
+	return true;
+}
+
+bool C4FindObjectAtRect::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_AtRect, bounds.x, bounds.y, bounds.Wdt, bounds.Hgt });
+	return true;
+}
+
+bool C4FindObjectOnLine::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_OnLine, x, y, x2, y2 });
+	return true;
+}
+
+bool C4FindObjectDistance::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Distance, x, y, r2 });
+	return true;
+}
+
+bool C4FindObjectCone::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Cone, x, y, r2, cone_angle, cone_width, prec_angle });
+	return true;
+}
+
+bool C4FindObjectOCF::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_OCF, ocf });
+	return true;
+}
+
+bool C4FindObjectCategory::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Category, iCategory });
+	return true;
+}
+
+bool C4FindObjectAction::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4FO_Action);
+	C4FindObject::GetKey(szAction, rKey);
+	return true;
+}
+
+bool C4FindObjectActionTarget::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_ActionTarget, ObjectKey(pActionTarget), index });
+	return true;
+}
+
+bool C4FindObjectProcedure::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4FO_Procedure);
+	C4FindObject::GetKey(procedure ? procedure->GetCStr() : nullptr, rKey);
+	return true;
+}
+
+bool C4FindObjectContainer::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Container, ObjectKey(pContainer) });
+	return true;
+}
+
+bool C4FindObjectAnyContainer::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4FO_AnyContainer);
+	return true;
+}
+
+bool C4FindObjectOwner::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Owner, iOwner });
+	return true;
+}
+
+bool C4FindObjectController::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Controller, controller });
+	return true;
+}
+
+bool C4FindObjectLayer::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4FO_Layer, ObjectKey(pLayer) });
+	return true;
+}
+
+bool C4FindObjectProperty::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4FO_Property);
+	C4FindObject::GetKey(Name ? Name->GetCStr() : nullptr, rKey);
+	return true;
+}
+
 // *** C4SortObject
 
 C4SortObject *C4SortObject::CreateByValue(const C4Value &DataVal, const C4Object *context)
@@ -1079,3 +1302,116 @@ int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
 	if (!Name) return false;
 	return pObj->Call(Name, &Pars).getInt();
 }
+
+bool C4SortObjectReverse::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4SO_Reverse);
+	return pSort->GetKey(rKey);
+}
+
+bool C4SortObjectMultiple::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4SO_Multiple, iCnt });
+	for (int32_t i = 0; i < iCnt; ++i)
+		if (!ppSorts[i]->GetKey(rKey))
+			return false;
+	return true;
+}
+
+bool C4SortObjectDistance::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.insert(rKey.end(), { C4SO_Distance, iX, iY });
+	return true;
+}
+
+bool C4SortObjectSpeed::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4SO_Speed);
+	return true;
+}
+
+bool C4SortObjectMass::GetKey(C4FindObjectKey &rKey)
+{
+	rKey.push_back(C4SO_Mass);
+	return true;
+}
+
+// *** C4FindObjectCache
+
+// Scripts doing lots of different searches would make the cache grow too much
+static const size_t C4FindObjectCache_MaxEntries = 4096;
+
+C4FindObjectCache::Entry *C4FindObjectCache::GetEntry(SearchType eType, C4FindObject &rFO, const C4LSectors &Sct)
+{
+	if (!Game.C4S.Game.FindObjectCache) return nullptr;
+	// results are only reused within the same frame
+	if (iFrame != Game.FrameCounter)
+	{
+		Clear();
+		iFrame = Game.FrameCounter;
+	}
+	C4FindObjectKey Key;
+	Key.push_back(eType);
+	if (!rFO.GetKey(Key)) return nullptr;
+	if (rFO.pSort && !rFO.pSort->GetKey(Key)) return nullptr;
+	if (Entries.size() >= C4FindObjectCache_MaxEntries && !Entries.count(Key))
+		Entries.clear();
+	Entry &rEntry = Entries[Key];
+	// anything changed in the searched area?
+	if (rEntry.fValid && Sct.HasChangedSince(rFO.GetBounds(), rEntry.iStamp))
+		rEntry.fValid = false;
+	if (!rEntry.fValid)
+		rEntry.iStamp = Sct.ChangeStamp;
+	return &rEntry;
+}
+
+int32_t C4FindObjectCache::Count(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	Entry *pEntry = GetEntry(ST_Count, rFO, Sct);
+	if (!pEntry) return rFO.Count(Objs, Sct);
+	if (!pEntry->fValid)
+	{
+		pEntry->iCount = rFO.Count(Objs, Sct);
+		pEntry->fValid = true;
+	}
+	return pEntry->iCount;
+}
+
+C4Object *C4FindObjectCache::Find(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	Entry *pEntry = GetEntry(ST_Find, rFO, Sct);
+	if (!pEntry) return rFO.Find(Objs, Sct);
+	if (!pEntry->fValid)
+	{
+		pEntry->Objects.assign(1, rFO.Find(Objs, Sct));
+		pEntry->fValid = true;
+	}
+	return pEntry->Objects[0];
+}
+
+C4ValueArray *C4FindObjectCache::FindMany(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct)
+{
+	Entry *pEntry = GetEntry(ST_FindMany, rFO, Sct);
+	if (!pEntry) return rFO.FindMany(Objs, Sct);
+	if (!pEntry->fValid)
+	{
+		C4ValueArray *pResult = rFO.FindMany(Objs, Sct);
+		pEntry->Objects.resize(pResult->GetSize());
+		for (int32_t i = 0; i < pResult->GetSize(); i++)
+			pEntry->Objects[i] = pResult->GetItem(i).getObj();
+		pEntry->fValid = true;
+		return pResult;
+	}
+	// same order as the original result
+	C4ValueArray *pResult = new C4ValueArray(pEntry->Objects.size());
+	for (size_t i = 0; i < pEntry->Objects.size(); i++)
+		(*pResult)[i] = C4VObj(pEntry->Objects[i]);
+	return pResult;
+}
+
+void C4FindObjectCache::Clear()
+{
+	Entries.clear();
+}
+
+C4FindObjectCache FindObjectCache;
@@ -65,12 +65,16 @@ enum C4SortObjectCondID
 	C4SO_Last         = 50  // no sort condition larger than this
 };
 
+// Identifies search conditions for C4FindObjectCache
+typedef std::vector<intptr_t> C4FindObjectKey;
+
 // Base class
 class C4FindObject
 {
 	friend class C4FindObjectNot;
 	friend class C4FindObjectAnd;
 	friend class C4FindObjectOr;
+	friend class C4FindObjectCache;
 
 	class C4SortObject *pSort{nullptr};
 public:
@@ -96,8 +100,20 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual bool GetKey(C4FindObjectKey &rKey) { return false; } // append key identifying the condition; false if results may not be cached
+
+	static bool GetKey(int32_t iType, int32_t iCnt, C4FindObject **ppConds, C4FindObjectKey &rKey);
+	static void GetKey(const char *szString, C4FindObjectKey &rKey);
 
 private:
+	// How to get at the objects within the bounds
+	enum SearchStrategy { SS_MainList, SS_Sectors, SS_Cells };
+	SearchStrategy PlanSearch(const C4LSectors &Sct);
+
+	template <class ObjectRange> int32_t CountIn(const ObjectRange &Objs);
+	template <class ObjectRange> C4Object *FindIn(const ObjectRange &Objs);
+	template <class ObjectRange> C4ValueArray *FindManyIn(const ObjectRange &Objs);
+
 	void CheckObjectStatus(C4ValueArray *pArray);
 };
 
@@ -114,6 +130,7 @@ protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override { return pCond->IsEnsured(); }
 	bool IsEnsured() override { return pCond->IsImpossible(); }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -132,6 +149,7 @@ protected:
 	bool IsEnsured() override { return !iCnt; }
 	bool IsImpossible() override;
 	void ForgetConditions() { ppConds=nullptr; iCnt=0; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 // Special variant of C4FindObjectAnd that does not free its conditions
@@ -158,6 +176,7 @@ protected:
 	bool UseShapes() override { return fUseShapes; }
 	bool IsEnsured() override;
 	bool IsImpossible() override { return !iCnt; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 // Primitive conditions
@@ -170,6 +189,7 @@ private:
 	C4Object *pExclude;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectDef : public C4FindObject
@@ -182,6 +202,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -195,6 +216,7 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &rect; }
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectAtPoint : public C4FindObject
@@ -208,6 +230,7 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectAtRect : public C4FindObject
@@ -221,6 +244,7 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectOnLine : public C4FindObject
@@ -235,6 +259,7 @@ protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
 	bool UseShapes() override { return true; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectDistance : public C4FindObject
@@ -248,6 +273,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectCone : public C4FindObject
@@ -261,6 +287,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	C4Rect *GetBounds() override { return &bounds; }
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectOCF : public C4FindObject
@@ -273,6 +300,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectCategory : public C4FindObject
@@ -285,6 +313,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsEnsured() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectAction : public C4FindObject
@@ -296,6 +325,7 @@ private:
 	const char *szAction;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectActionTarget : public C4FindObject
@@ -308,6 +338,7 @@ private:
 	int index;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectProcedure : public C4FindObject
@@ -320,6 +351,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectContainer : public C4FindObject
@@ -331,6 +363,7 @@ private:
 	C4Object *pContainer;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectAnyContainer : public C4FindObject
@@ -339,6 +372,7 @@ public:
 	C4FindObjectAnyContainer() = default;
 protected:
 	bool Check(C4Object *pObj) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectOwner : public C4FindObject
@@ -351,6 +385,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectController : public C4FindObject
@@ -363,6 +398,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectFunc : public C4FindObject
@@ -387,6 +423,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectLayer : public C4FindObject
@@ -398,6 +435,7 @@ private:
 protected:
 	bool Check(C4Object *pObj) override;
 	bool IsImpossible() override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4FindObjectInArray : public C4FindObject
@@ -424,6 +462,7 @@ public:
 
 	virtual bool PrepareCache(const C4ValueArray *pObjs) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
+	virtual bool GetKey(C4FindObjectKey &rKey) { return false; } // see C4FindObject::GetKey
 
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data, const C4Object *context=nullptr);
@@ -466,6 +505,7 @@ protected:
 
 	bool PrepareCache(const C4ValueArray *pObjs) override;
 	int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
@@ -484,6 +524,7 @@ protected:
 
 	bool PrepareCache(const C4ValueArray *pObjs) override;
 	int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
@@ -496,6 +537,7 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4SortObjectRandom : public C4SortObjectByValue // randomize order
@@ -514,6 +556,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4SortObjectMass : public C4SortObjectByValue // sort by mass
@@ -523,6 +566,7 @@ public:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	bool GetKey(C4FindObjectKey &rKey) override;
 };
 
 class C4SortObjectValue : public C4SortObjectByValue // sort by value
@@ -546,4 +590,32 @@ protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
 };
 
-#endif
+// Results of script searches, reused by identical searches within the same frame as long as no
+// object in the searched area has been added, removed, moved or reshaped. Other changes of objects
+// (e.g. OCF, owner or action) are not tracked, so scenarios need to enable this explicitly.
+class C4FindObjectCache
+{
+public:
+	int32_t Count(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct);
+	C4Object *Find(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct);
+	C4ValueArray *FindMany(C4FindObject &rFO, const C4ObjectList &Objs, const C4LSectors &Sct); // return is to be freed by the caller
+	void Clear();
+
+private:
+	enum SearchType { ST_Count, ST_Find, ST_FindMany };
+	struct Entry
+	{
+		bool fValid{false};
+		uint64_t iStamp{0}; // sector change stamp at the time of the search
+		int32_t iCount{0};
+		std::vector<C4Object *> Objects;
+	};
+	std::map<C4FindObjectKey, Entry> Entries;
+	int32_t iFrame{-1};
+
+	Entry *GetEntry(SearchType eType, C4FindObject &rFO, const C4LSectors &Sct);
+};
+
+extern C4FindObjectCache FindObjectCache;
+
+#endif
\ No newline at end of file
@@ -204,6 +204,7 @@ void C4GameObjects::DeleteObjects(bool fDeleteInactive)
 {
 	C4ObjectList::DeleteObjects();
 	Sectors.ClearObjects();
+	::FindObjectCache.Clear();
 	ForeObjects.Clear();
 	if (fDeleteInactive) InactiveObjects.DeleteObjects();
 }
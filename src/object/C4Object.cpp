@@ -295,6 +295,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 		Status = C4OS_NORMAL;
 		::Objects.Add(this);
 	}
+	::Objects.Sectors.MarkChanged(this);
 	Status=0;
 	// count decrease
 	Def->Count--;
@@ -4888,6 +4889,12 @@ bool C4Object::GetPropertyByS(const C4String *k, C4Value *pResult) const
 	return C4PropListNumbered::GetPropertyByS(k, pResult);
 }
 
+bool C4Object::IsReflectedProperty(const C4String *k) const
+{
+	// keep in sync with GetPropertyByS
+	return k == &Strings.P[P_Plane] || C4PropListNumbered::IsReflectedProperty(k);
+}
+
 C4ValueArray * C4Object::GetProperties() const
 {
 	C4ValueArray * a = C4PropList::GetProperties();
@@ -376,6 +376,7 @@ public:
 	void SetPropertyByS(C4String * k, const C4Value & to) override;
 	void ResetProperty(C4String * k) override;
 	bool GetPropertyByS(const C4String *k, C4Value *pResult) const override;
+	bool IsReflectedProperty(const C4String *k) const override;
 	C4ValueArray * GetProperties() const override;
 };
 
@@ -51,6 +51,7 @@ void C4LSector::ClearObjects()
 	// clear objects
 	Objects.Clear();
 	ObjectShapes.Clear();
+	ObjectCount = 0;
 }
 
 /* sector map */
@@ -69,6 +70,11 @@ void C4LSectors::Init(int iWdt, int iHgt)
 	for (int cnt=0; cnt<Size; cnt++, sct++)
 		sct->Init(cnt%Wdt, cnt/Wdt);
 	SectorOut.Init(-1,-1); // outpos at -1,-1 - MUST NOT intersect with an inside sector!
+	// create fine grid
+	CellWdt = (PxWdt-1)/C4LCellWdt+1;
+	CellHgt = (PxHgt-1)/C4LCellHgt+1;
+	Cells.resize(CellWdt*CellHgt);
+	ObjectCount = 0;
 }
 
 void C4LSectors::Clear()
@@ -77,6 +83,10 @@ void C4LSectors::Clear()
 	SectorOut.Clear();
 	// free sectors
 	delete [] Sectors; Sectors=nullptr;
+	// free fine grid
+	Cells.clear(); CellOut.clear();
+	CellWdt = CellHgt = 0;
+	ObjectCount = 0;
 }
 
 C4LSector *C4LSectors::SectorAt(int ix, int iy)
@@ -88,20 +98,66 @@ C4LSector *C4LSectors::SectorAt(int ix, int iy)
 	return Sectors+(iy/C4LSectorHgt)*Wdt+(ix/C4LSectorWdt);
 }
 
+std::vector<C4Object *> &C4LSectors::CellAt(int ix, int iy)
+{
+	// check bounds
+	if (ix<0 || iy<0 || ix>=PxWdt || iy>=PxHgt)
+		return CellOut;
+	// get cell
+	return Cells[(iy/C4LCellHgt)*CellWdt+(ix/C4LCellWdt)];
+}
+
+void C4LSectors::AddToCell(C4Object *pObj)
+{
+	// insert at saved position, sorted by number
+	std::vector<C4Object *> &rCell = CellAt(pObj->old_x, pObj->old_y);
+	auto pos = std::find_if(rCell.begin(), rCell.end(), [pObj](C4Object *pOther) { return pOther->Number > pObj->Number; });
+	rCell.insert(pos, pObj);
+}
+
+void C4LSectors::RemoveFromCell(C4Object *pObj)
+{
+	std::vector<C4Object *> &rCell = CellAt(pObj->old_x, pObj->old_y);
+	auto pos = std::find(rCell.begin(), rCell.end(), pObj);
+	if (pos != rCell.end())
+	{
+		rCell.erase(pos);
+		return;
+	}
+	// not at its saved position? Same recovery as for the sector lists.
+	for (std::vector<C4Object *> &rOtherCell : Cells)
+		if ((pos = std::find(rOtherCell.begin(), rOtherCell.end(), pObj)) != rOtherCell.end())
+			{ rOtherCell.erase(pos); return; }
+	if ((pos = std::find(CellOut.begin(), CellOut.end(), pObj)) != CellOut.end())
+		{ CellOut.erase(pos); return; }
+	assert(false);
+}
+
+void C4LSectors::MarkChanged(C4Object *pObj)
+{
+	++ChangeStamp;
+	SectorAt(pObj->old_x, pObj->old_y)->ChangeStamp = ChangeStamp;
+	for (C4LSector *pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
+		pSct->ChangeStamp = ChangeStamp;
+}
+
 void C4LSectors::Add(C4Object *pObj, C4ObjectList *pMainList)
 {
 	assert(Sectors);
 	// Add to owning sector
 	C4LSector *pSct = SectorAt(pObj->GetX(), pObj->GetY());
 	pSct->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+	++pSct->ObjectCount; ++ObjectCount;
 	// Save position
 	pObj->old_x = pObj->GetX(); pObj->old_y = pObj->GetY();
+	AddToCell(pObj);
 	// Add to all sectors in shape area
 	pObj->Area.Set(this, pObj);
 	for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
 	{
 		pSct->ObjectShapes.Add(pObj, C4ObjectList::stMain, pMainList);
 	}
+	MarkChanged(pObj);
 	if (Config.General.DebugRec)
 		pObj->Area.DebugRec(pObj, 'A');
 }
@@ -115,6 +171,8 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 		Add(pObj, pMainList);
 		return;
 	}
+	// The position or shape might have changed
+	MarkChanged(pObj);
 	C4LSector *pOld, *pNew;
 	if (pObj->old_x != pObj->GetX() || pObj->old_y != pObj->GetY())
 	{
@@ -123,15 +181,18 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 		pNew = SectorAt(pObj->GetX(), pObj->GetY());
 		if (pOld != pNew)
 		{
-			pOld->Objects.Remove(pObj);
-			pNew->Objects.Add(pObj, C4ObjectList::stMain, pMainList);
+			pOld->Objects.Remove(pObj); --pOld->ObjectCount;
+			pNew->Objects.Add(pObj, C4ObjectList::stMain, pMainList); ++pNew->ObjectCount;
 		}
+		bool fNewCell = &CellAt(pObj->old_x, pObj->old_y) != &CellAt(pObj->GetX(), pObj->GetY());
+		if (fNewCell) RemoveFromCell(pObj);
 		// Save position
 		pObj->old_x = pObj->GetX(); pObj->old_y = pObj->GetY();
+		if (fNewCell) AddToCell(pObj);
 	}
 	// New area
 	C4LArea NewArea(this, pObj);
-	if (pObj->Area == NewArea) return;
+	if (pObj->Area == NewArea) { MarkChanged(pObj); return; }
 	// Remove from all old sectors in shape area
 	for (pOld = pObj->Area.First(); pOld; pOld = pObj->Area.Next(pOld))
 		if (!NewArea.Contains(pOld))
@@ -144,6 +205,7 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 		}
 	// Update area
 	pObj->Area = NewArea;
+	MarkChanged(pObj);
 	if (Config.General.DebugRec)
 		pObj->Area.DebugRec(pObj, 'U');
 }
@@ -151,6 +213,7 @@ void C4LSectors::Update(C4Object *pObj, C4ObjectList *pMainList)
 void C4LSectors::Remove(C4Object *pObj)
 {
 	assert(Sectors); assert(pObj);
+	MarkChanged(pObj);
 	// Remove from owning sector
 	C4LSector *pSct = SectorAt(pObj->old_x, pObj->old_y);
 	if (!pSct->Objects.Remove(pObj))
@@ -166,7 +229,9 @@ void C4LSectors::Remove(C4Object *pObj)
 		if (!fFound)
 		{
 			fFound = !!SectorOut.Objects.Remove(pObj);
-			if (!fFound)
+			if (fFound)
+				pSct = &SectorOut;
+			else
 			{
 				pSct = Sectors;
 				for (int cnt=0; cnt<Size; cnt++, pSct++)
@@ -174,7 +239,10 @@ void C4LSectors::Remove(C4Object *pObj)
 			}
 			assert(fFound);
 		}
+		if (!fFound) pSct = nullptr;
 	}
+	if (pSct) { --pSct->ObjectCount; --ObjectCount; }
+	RemoveFromCell(pObj);
 	// Remove from all sectors in shape area
 	for (pSct = pObj->Area.First(); pSct; pSct = pObj->Area.Next(pSct))
 		pSct->ObjectShapes.Remove(pObj);
@@ -229,6 +297,71 @@ void C4LSectors::ClearObjects()
 		for (int cnt=0; cnt<Size; cnt++) Sectors[cnt].ClearObjects();
 	}
 	SectorOut.ClearObjects();
+	for (std::vector<C4Object *> &rCell : Cells) rCell.clear();
+	CellOut.clear();
+	ObjectCount = 0;
+}
+
+// Clips the rect to the landscape, returning in which cells of the given size it lies
+// and whether it reaches outside
+static bool GetGridRange(const C4Rect &Rect, int iPxWdt, int iPxHgt, int iCellWdt, int iCellHgt, int &x0, int &y0, int &x1, int &y1)
+{
+	C4Rect Normalized(Rect);
+	Normalized.Normalize();
+	bool fOut = Normalized.x < 0 || Normalized.y < 0 || Normalized.x + Normalized.Wdt > iPxWdt || Normalized.y + Normalized.Hgt > iPxHgt;
+	// a degenerated rect still needs to look at the cell it's in
+	int xr = Normalized.x + std::max<int>(Normalized.Wdt, 1), yr = Normalized.y + std::max<int>(Normalized.Hgt, 1);
+	x0 = std::max<int>(Normalized.x, 0) / iCellWdt; x1 = (std::min<int>(xr, iPxWdt) - 1) / iCellWdt;
+	y0 = std::max<int>(Normalized.y, 0) / iCellHgt; y1 = (std::min<int>(yr, iPxHgt) - 1) / iCellHgt;
+	if (xr <= 0 || yr <= 0 || Normalized.x >= iPxWdt || Normalized.y >= iPxHgt || iPxWdt <= 0 || iPxHgt <= 0)
+		{ x0 = y0 = 0; x1 = y1 = -1; }
+	return fOut;
+}
+
+int32_t C4LSectors::GetObjectCount(const C4Rect &Rect, int32_t *piSectorCount) const
+{
+	int x0, y0, x1, y1;
+	bool fOut = GetGridRange(Rect, PxWdt, PxHgt, C4LSectorWdt, C4LSectorHgt, x0, y0, x1, y1);
+	int32_t iCount = fOut ? SectorOut.ObjectCount : 0;
+	for (int y = y0; y <= y1; ++y)
+		for (int x = x0; x <= x1; ++x)
+			iCount += Sectors[y*Wdt+x].ObjectCount;
+	if (piSectorCount) *piSectorCount = std::max(x1 - x0 + 1, 0) * std::max(y1 - y0 + 1, 0) + fOut;
+	return iCount;
+}
+
+bool C4LSectors::HasChangedSince(const C4Rect *pRect, uint64_t iStamp) const
+{
+	if (ChangeStamp <= iStamp) return false;
+	if (!pRect) return true;
+	int x0, y0, x1, y1;
+	bool fOut = GetGridRange(*pRect, PxWdt, PxHgt, C4LSectorWdt, C4LSectorHgt, x0, y0, x1, y1);
+	if (fOut && SectorOut.ChangeStamp > iStamp) return true;
+	for (int y = y0; y <= y1; ++y)
+		for (int x = x0; x <= x1; ++x)
+			if (Sectors[y*Wdt+x].ChangeStamp > iStamp)
+				return true;
+	return false;
+}
+
+int32_t C4LSectors::GetCellCount(const C4Rect &Rect) const
+{
+	int x0, y0, x1, y1;
+	bool fOut = GetGridRange(Rect, PxWdt, PxHgt, C4LCellWdt, C4LCellHgt, x0, y0, x1, y1);
+	return std::max(x1 - x0 + 1, 0) * std::max(y1 - y0 + 1, 0) + fOut;
+}
+
+void C4LSectors::GetCellObjects(const C4Rect &Rect, std::vector<C4Object *> &rObjects) const
+{
+	int x0, y0, x1, y1;
+	bool fOut = GetGridRange(Rect, PxWdt, PxHgt, C4LCellWdt, C4LCellHgt, x0, y0, x1, y1);
+	for (int y = y0; y <= y1; ++y)
+		for (int x = x0; x <= x1; ++x)
+		{
+			const std::vector<C4Object *> &rCell = Cells[y*CellWdt+x];
+			rObjects.insert(rObjects.end(), rCell.begin(), rCell.end());
+		}
+	if (fOut) rObjects.insert(rObjects.end(), CellOut.begin(), CellOut.end());
 }
 
 /* landscape area */
@@ -30,6 +30,9 @@ class C4LArea;
 // constants
 const int32_t C4LSectorWdt = 50,
                              C4LSectorHgt = 50;
+// fine grid of object positions; cells nest within sectors
+const int32_t C4LCellWdt = 10,
+                           C4LCellHgt = 10;
 
 // one of those object list sectors
 class C4LSector
@@ -47,6 +50,8 @@ public:
 
 	C4ObjectList Objects; // objects within this sector
 	C4ObjectList ObjectShapes; // objects with shapes that overlap this sector
+	int32_t ObjectCount{0}; // number of objects in Objects list - NoSave //
+	uint64_t ChangeStamp{0}; // last time an object in this sector was added, removed, moved or reshaped - NoSave //
 
 	void CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers);
 	void ClearObjects(); // remove all objects from object lists
@@ -64,10 +69,31 @@ public:
 
 	C4LSector SectorOut; // the sector "outside"
 
+	// Object positions in a grid finer than the sectors, to speed up searches in small
+	// areas of crowded sectors. Objects within a cell are sorted by number, so the order
+	// does not depend on the history of insertions and is the same after a runtime join.
+	std::vector<std::vector<C4Object *> > Cells;
+	std::vector<C4Object *> CellOut; // objects outside the landscape
+	int CellWdt, CellHgt; // cell count
+	int32_t ObjectCount; // number of objects in all position sectors
+	uint64_t ChangeStamp; // last change of any object
+
+protected:
+	std::vector<C4Object *> &CellAt(int ix, int iy);
+	void AddToCell(C4Object *pObj);
+	void RemoveFromCell(C4Object *pObj);
+
 public:
 	void Init(int Wdt, int Hgt); // init map sectors
 	void Clear(); // free map sectors
 	C4LSector *SectorAt(int ix, int iy); // get sector at pos
+	const C4LSector *SectorAt(int ix, int iy) const { return const_cast<C4LSectors *>(this)->SectorAt(ix, iy); }
+
+	int32_t GetObjectCount(const C4Rect &Rect, int32_t *piSectorCount = nullptr) const; // count objects positioned in sectors overlapping the rect
+	int32_t GetCellCount(const C4Rect &Rect) const; // number of fine grid cells overlapping the rect
+	void GetCellObjects(const C4Rect &Rect, std::vector<C4Object *> &rObjects) const; // append objects of all fine grid cells overlapping the rect
+	bool HasChangedSince(const C4Rect *pRect, uint64_t iStamp) const; // any object positioned or shaped within the rect changed? No rect for everywhere.
+	void MarkChanged(C4Object *pObj); // update change stamps of the sectors of object position and shape
 
 	void Add(C4Object *pObj, C4ObjectList *pMainList);
 	void Update(C4Object *pObj, C4ObjectList *pMainList); // does not update object order!
@@ -56,9 +56,9 @@ bool C4SoundEffect::Load(const char *szFileName, C4Group &hGroup, const char *na
 	if (!Config.Sound.RXSound) return false;
 	// Locate sound in file
 	StdBuf WaveBuffer;
-	if (!hGroup.LoadEntry(szFileName, &WaveBuffer)) return false;
+	if (!hGroup.LoadEntryView(szFileName, &WaveBuffer)) return false;
 	// load it from mem
-	if (!Load((BYTE*)WaveBuffer.getMData(), WaveBuffer.getSize())) return false;
+	if (!Load(getBufPtr<BYTE>(WaveBuffer), WaveBuffer.getSize())) return false;
 	// Set name
 	if (namespace_prefix)
 	{
@@ -75,7 +75,7 @@ bool C4SoundEffect::Load(const char *szFileName, C4Group &hGroup, const char *na
 	return true;
 }
 
-bool C4SoundEffect::Load(BYTE *pData, size_t iDataLen, bool fRaw)
+bool C4SoundEffect::Load(const BYTE *pData, size_t iDataLen, bool fRaw)
 {
 	// Sound check
 	if (!Config.Sound.RXSound) return false;
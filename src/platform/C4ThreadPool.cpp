@@ -0,0 +1,99 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "platform/C4ThreadPool.h"
+
+// never spread a loop over more threads than this
+static const int32_t C4ThreadPool_MaxWorkers = 31;
+
+void C4ThreadPool::SetWorkerCount(int32_t iNewCount)
+{
+	if (iNewCount < 0)
+		iNewCount = static_cast<int32_t>(std::thread::hardware_concurrency()) - 1;
+	iNewCount = Clamp<int32_t>(iNewCount, 0, C4ThreadPool_MaxWorkers);
+	if (iNewCount == GetWorkerCount()) return;
+	// stop previous workers
+	if (!Workers.empty())
+	{
+		{
+			std::lock_guard<std::mutex> Lock(Mutex);
+			fStop = true;
+		}
+		WorkAvailable.notify_all();
+		for (std::thread &Worker : Workers) Worker.join();
+		Workers.clear();
+		fStop = false;
+	}
+	// launch new ones
+	Workers.reserve(iNewCount);
+	for (int32_t i = 0; i < iNewCount; ++i)
+		Workers.emplace_back(&C4ThreadPool::WorkerMain, this);
+}
+
+void C4ThreadPool::WorkerMain()
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	uint32_t iLastJob = iJob;
+	for (;;)
+	{
+		WorkAvailable.wait(Lock, [this, iLastJob] { return fStop || iJob != iLastJob; });
+		if (fStop) return;
+		iLastJob = iJob;
+		while (ExecuteSlice(Lock)) {}
+	}
+}
+
+bool C4ThreadPool::ExecuteSlice(std::unique_lock<std::mutex> &Lock)
+{
+	// called with locked mutex; grab next slice of the current job
+	if (!pBody || iNextSlice >= iSliceCount) return false;
+	size_t iBegin = iNextSlice++ * iSliceSize;
+	size_t iEnd = std::min(iBegin + iSliceSize, iCount);
+	const SliceFunc &fnBody = *pBody;
+	Lock.unlock();
+	fnBody(iBegin, iEnd);
+	Lock.lock();
+	if (++iSlicesDone == iSliceCount) WorkDone.notify_all();
+	return true;
+}
+
+void C4ThreadPool::ParallelFor(size_t iNewCount, size_t iMinSlice, const SliceFunc &fnBody)
+{
+	if (!iNewCount) return;
+	// not worth distributing?
+	iMinSlice = std::max<size_t>(iMinSlice, 1);
+	if (Workers.empty() || iNewCount <= iMinSlice)
+	{
+		fnBody(0, iNewCount);
+		return;
+	}
+	// a few slices per thread so uneven slices balance out
+	std::unique_lock<std::mutex> Lock(Mutex);
+	size_t iThreads = Workers.size() + 1;
+	pBody = &fnBody;
+	iCount = iNewCount;
+	iSliceSize = std::max(iMinSlice, (iNewCount + iThreads * 4 - 1) / (iThreads * 4));
+	iSliceCount = (iNewCount + iSliceSize - 1) / iSliceSize;
+	iNextSlice = iSlicesDone = 0;
+	++iJob;
+	WorkAvailable.notify_all();
+	// help out, then wait for the remaining slices
+	while (ExecuteSlice(Lock)) {}
+	WorkDone.wait(Lock, [this] { return iSlicesDone == iSliceCount; });
+	pBody = nullptr;
+}
+
+C4ThreadPool ThreadPool;
@@ -0,0 +1,72 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Worker threads for data-parallel loops.
+
+   ParallelFor splits an index range into slices and runs them on the worker
+   threads and the calling thread, returning once all slices are done. Which
+   thread processes which slice is arbitrary, so the loop body must not
+   depend on it: Slices may only write to their own part of the output and
+   must not touch any synchronized game state. Everything that has to happen
+   in a defined order (and thus in sync) stays on the main thread.
+
+   With zero workers, the whole range is processed by the calling thread. */
+
+#ifndef INC_C4ThreadPool
+#define INC_C4ThreadPool
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class C4ThreadPool
+{
+public:
+	C4ThreadPool() = default;
+	~C4ThreadPool() { SetWorkerCount(0); }
+	C4ThreadPool(const C4ThreadPool &) = delete;
+	C4ThreadPool &operator=(const C4ThreadPool &) = delete;
+
+	typedef std::function<void(size_t, size_t)> SliceFunc;
+
+private:
+	std::vector<std::thread> Workers;
+	std::mutex Mutex;
+	std::condition_variable WorkAvailable, WorkDone;
+	// current job: slices of [0, iCount) with iSliceSize elements each
+	const SliceFunc *pBody{nullptr};
+	size_t iCount{0}, iSliceSize{0}, iNextSlice{0}, iSliceCount{0}, iSlicesDone{0};
+	uint32_t iJob{0};
+	bool fStop{false};
+
+	void WorkerMain();
+	bool ExecuteSlice(std::unique_lock<std::mutex> &Lock);
+
+public:
+	// iCount < 0 picks one worker less than there are hardware threads
+	void SetWorkerCount(int32_t iCount);
+	int32_t GetWorkerCount() const { return Workers.size(); }
+	bool IsParallel() const { return !Workers.empty(); }
+
+	// Calls fnBody(iBegin, iEnd) for consecutive slices of [0, iCount) that hold at least iMinSlice
+	// elements each (except for the last). May not be called from within a slice.
+	void ParallelFor(size_t iCount, size_t iMinSlice, const SliceFunc &fnBody);
+};
+
+extern C4ThreadPool ThreadPool;
+
+#endif
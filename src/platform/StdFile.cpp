@@ -31,6 +31,10 @@
 #endif
 #include <sys/types.h>
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <fcntl.h>
+#endif
 #include <zlib.h>
 
 /* Path & Filename */
@@ -1082,3 +1086,48 @@ int ForEachFile(const char *szDirName, bool (*fnCallback)(const char *))
 #endif
 	return iFileCount;
 }
+
+/* Memory mapped files */
+
+bool MappedFile::Open(const char *szFilename)
+{
+	Close();
+#ifdef _WIN32
+	HANDLE hFile = CreateFileW(GetWideChar(szFilename), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER FileSize;
+	if (!GetFileSizeEx(hFile, &FileSize)) { CloseHandle(hFile); return false; }
+	iSize = static_cast<size_t>(FileSize.QuadPart);
+	if (iSize)
+	{
+		// the mapping keeps the file open
+		hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (hMapping) pData = static_cast<const BYTE *>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	CloseHandle(hFile);
+#else
+	int fd = open(szFilename, O_RDONLY | O_CLOEXEC);
+	if (fd == -1) return false;
+	iSize = FileSize(fd);
+	if (iSize)
+	{
+		void *pMap = mmap(nullptr, iSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (pMap != MAP_FAILED) pData = static_cast<const BYTE *>(pMap);
+	}
+	close(fd);
+#endif
+	if (iSize && !pData) { Close(); return false; }
+	return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (pData) UnmapViewOfFile(pData);
+	if (hMapping) CloseHandle(hMapping);
+	hMapping = nullptr;
+#else
+	if (pData) munmap(const_cast<BYTE *>(pData), iSize);
+#endif
+	pData = nullptr; iSize = 0;
+}
@@ -109,4 +109,26 @@ private:
 	FileList::iterator iter;
 };
 
+// Read-only view of a whole file. Pages are only read from disk (or shared with the
+// page cache) when they are accessed. Zero-sized files map to a null pointer.
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile() { Close(); }
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	bool Open(const char *szFilename);
+	void Close();
+	const BYTE *getData() const { return pData; }
+	size_t getSize() const { return iSize; }
+private:
+	const BYTE *pData = nullptr;
+	size_t iSize = 0;
+#ifdef _WIN32
+	void *hMapping = nullptr;
+#endif
+};
+
 #endif // STDFILE_INCLUDED
@@ -20,6 +20,7 @@
 
 #include "c4group/C4Components.h"
 #include "c4group/C4LangStringTable.h"
+#include "script/C4AulCodeCache.h"
 #include "script/C4AulDebug.h"
 #include "script/C4AulExec.h"
 #include "script/C4Effect.h"
@@ -273,6 +274,14 @@ void C4AulScriptEngine::UnregisterErrorHandler(C4AulErrorHandler *handler)
 	ErrorHandler = &DefaultErrorHandler;
 }
 
+void C4AulScriptEngine::SetCodeCache(const char *szFilename, const char *szEngineVersion)
+{
+	if (szFilename)
+		CodeCache = std::make_unique<C4AulCodeCache>(szFilename, szEngineVersion);
+	else
+		CodeCache.reset();
+}
+
 /*--- C4AulFuncMap ---*/
 
 C4AulFuncMap::C4AulFuncMap()
@@ -34,6 +34,8 @@ enum class C4AulWarningId
 	WarningCount
 };
 
+class C4AulCodeCache;
+
 extern const char *C4AulWarningIDs[];
 extern const char *C4AulWarningMessages[];
 
@@ -127,6 +129,8 @@ protected:
 
 	C4AulErrorHandler *ErrorHandler;
 
+	std::unique_ptr<C4AulCodeCache> CodeCache; // byte code kept between runs; may be nullptr
+
 public:
 	int warnCnt{0}, errCnt{0}; // number of warnings/errors
 	int lineCnt{0}; // line count parsed
@@ -175,12 +179,17 @@ public:
 		return ErrorHandler;
 	}
 
+	// Keep generated byte code in the given file; nullptr to disable
+	void SetCodeCache(const char *szFilename, const char *szEngineVersion);
+	C4AulCodeCache *GetCodeCache() const { return CodeCache.get(); }
+
 	friend class C4AulFunc;
 	friend class C4AulProfiler;
 	friend class C4ScriptHost;
 	friend class C4AulParse;
 	friend class C4AulCompiler;
 	friend class C4AulDebug;
+	friend class C4AulCodeCache;
 };
 
 extern C4AulScriptEngine ScriptEngine;
@@ -0,0 +1,432 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Include.h"
+#include "script/C4AulCodeCache.h"
+
+#include "script/C4Aul.h"
+#include "script/C4AulScriptFunc.h"
+#include "script/C4ScriptHost.h"
+
+#include "blake2.h"
+
+// bump whenever the meaning of cached code changes without the engine version changing
+static const int32_t C4AulCodeCache_FormatVersion = 1;
+static const size_t C4AulCodeCache_KeyLength = 32;
+static const uint32_t C4AulCodeCache_MaxFunctionSize = 1 << 20;
+
+// how an AB_FUNC callee is found again; stored in the low bits of the chunk parameter
+enum
+{
+	C4AulCodeCache_FuncOverloaded = 0,
+	C4AulCodeCache_FuncLocal = 1,
+	C4AulCodeCache_FuncGlobal = 2,
+};
+
+static bool IsStringChunk(C4AulBCCType eType)
+{
+	switch (eType)
+	{
+	case AB_STRING: case AB_CALL: case AB_CALLFS: case AB_LOCALN: case AB_LOCALN_SET: case AB_PROP: case AB_PROP_SET:
+		return true;
+	default:
+		return false;
+	}
+}
+
+const char *C4AulCodeCache::GetScriptBase(const C4AulScriptFunc *pFunc, size_t *piLength)
+{
+	// positions are relative to the same text C4AulScriptFunc::GetLineOfCode uses
+	if (!pFunc->pOrgScript) return nullptr;
+	*piLength = pFunc->pOrgScript->Script.getLength();
+	return pFunc->pOrgScript->GetScript();
+}
+
+static_assert(sizeof(C4AulCodeCache::Chunk) == 3 * sizeof(int32_t), "chunks are stored as raw memory");
+
+void C4AulCodeCache::Function::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(Name);
+	// chunks are plain integers, so they are kept as one block
+	uint32_t iCount = Code.size();
+	pComp->Value(mkIntPackAdapt(iCount));
+	if (pComp->isDeserializer())
+	{
+		if (iCount > C4AulCodeCache_MaxFunctionSize)
+			pComp->excCorrupt("function too long");
+		Code.resize(iCount);
+	}
+	if (iCount)
+		pComp->Raw(&Code[0], iCount * sizeof(Chunk), StdCompiler::RCT_All);
+}
+
+void C4AulCodeCache::Host::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(ScriptName);
+	pComp->Value(Valid);
+	pComp->Value(mkSTLContainerAdapt(Strings));
+	pComp->Value(mkSTLContainerAdapt(Functions));
+}
+
+C4AulCodeCache::C4AulCodeCache(const char *szFilename, const char *szEngineVersion)
+	: Filename(szFilename), EngineVersion(szEngineVersion)
+{
+	// a missing or broken file just means everything gets compiled
+	StdBuf Buf;
+	if (!Buf.LoadFromFile(Filename.getData())) return;
+	try
+	{
+		CompileFromBuf<StdCompilerBinRead>(*this, Buf);
+	}
+	catch (StdCompiler::Exception *pExc)
+	{
+		delete pExc;
+		Key.Clear();
+		Hosts.clear();
+	}
+}
+
+void C4AulCodeCache::CompileFunc(StdCompiler *pComp)
+{
+	StdCopyStrBuf Version(EngineVersion);
+	pComp->Value(Version);
+	if (pComp->isDeserializer() && Version != EngineVersion)
+		pComp->excCorrupt("script cache of a different engine version");
+	pComp->Value(Key);
+	pComp->Value(mkSTLContainerAdapt(Hosts));
+}
+
+StdCopyStrBuf C4AulCodeCache::CalculateKey() const
+{
+	blake2b_state State;
+	blake2b_init(&State, C4AulCodeCache_KeyLength);
+	auto HashData = [&State](const void *pData, size_t iSize) { blake2b_update(&State, pData, iSize); };
+	auto HashStr = [&HashData](const char *szStr) { if (!szStr) szStr = ""; HashData(szStr, strlen(szStr) + 1); };
+	auto HashInt = [&HashData](int32_t i) { HashData(&i, sizeof(i)); };
+	HashStr(EngineVersion.getData());
+	HashInt(C4AulCodeCache_FormatVersion);
+	HashInt(AB_EOFN);
+	// script texts and everything identifiers might resolve to;
+	// proplists shared as prototypes are only hashed the first time
+	std::map<const C4PropList *, int32_t> HashedProps;
+	auto HashPropsChain = [&HashStr, &HashInt, &HashedProps](const C4PropList *pProps)
+	{
+		for (; pProps; pProps = pProps->GetPrototype())
+		{
+			auto i = HashedProps.find(pProps);
+			if (i != HashedProps.end())
+			{
+				HashInt(i->second);
+				return;
+			}
+			HashedProps.emplace(pProps, HashedProps.size());
+			for (C4String *pName : pProps->GetSortedLocalProperties(false))
+				HashStr(pName->GetCStr());
+			HashStr(nullptr);
+		}
+		HashInt(-1);
+	};
+	for (C4ScriptHost *pHost = pEngine->Child0; pHost; pHost = pHost->Next)
+	{
+		HashStr(pHost->ScriptName.getData());
+		HashData(pHost->Script.getData(), pHost->Script.getLength());
+		HashStr(nullptr);
+		HashPropsChain(pHost->GetPropList());
+	}
+	HashPropsChain(pEngine);
+	for (int32_t i = 0; i < pEngine->GlobalNamedNames.iSize; ++i)
+		HashStr(pEngine->GlobalNamedNames.pNames[i]);
+	for (int32_t i = 0; i < pEngine->GlobalConstNames.iSize; ++i)
+	{
+		HashStr(pEngine->GlobalConstNames.pNames[i]);
+		const C4Value &Value = pEngine->GlobalConsts[i];
+		HashInt(Value.GetType());
+		if (Value.GetType() == C4V_Int || Value.GetType() == C4V_Bool)
+			HashInt(Value._getInt());
+		else if (Value.GetType() == C4V_String)
+			HashStr(Value._getStr()->GetCStr());
+	}
+	uint8_t Hash[C4AulCodeCache_KeyLength];
+	blake2b_final(&State, Hash, sizeof(Hash));
+	StdCopyStrBuf Result;
+	for (uint8_t b : Hash) Result.AppendFormat("%02x", (unsigned int) b);
+	return Result;
+}
+
+int32_t C4AulCodeCache::GetStringIndex(C4String *pStr)
+{
+	auto i = RecordedStrings.find(pStr);
+	if (i != RecordedStrings.end()) return i->second;
+	int32_t iIndex = Recording.Strings.size();
+	Recording.Strings.emplace_back(pStr->GetCStr());
+	RecordedStrings[pStr] = iIndex;
+	return iIndex;
+}
+
+int32_t C4AulCodeCache::GetConstantIndex(C4V_Type eType, const void *pData) const
+{
+	for (int32_t i = 0; i < pEngine->GlobalConstNames.iSize; ++i)
+	{
+		const C4Value &Value = pEngine->GlobalConsts[i];
+		if (Value.GetType() != eType) continue;
+		if ((eType == C4V_PropList && Value._getPropList() == pData)
+		 || (eType == C4V_Array && Value._getArray() == pData)
+		 || (eType == C4V_Function && Value._getFunction() == pData))
+			return i;
+	}
+	return -1;
+}
+
+bool C4AulCodeCache::EncodeFunction(C4AulScriptFunc *pFunc, Function &Out)
+{
+	size_t iScriptLength = 0;
+	const char *szScript = GetScriptBase(pFunc, &iScriptLength);
+	if (!szScript) return false;
+	Out.Name.Copy(pFunc->GetName());
+	Out.Code.resize(pFunc->Code.size());
+	for (size_t i = 0; i < pFunc->Code.size(); ++i)
+	{
+		const C4AulBCC &BCC = pFunc->Code[i];
+		Chunk &Out_Chunk = Out.Code[i];
+		Out_Chunk.Type = BCC.bccType;
+		if (IsStringChunk(BCC.bccType))
+			Out_Chunk.Par = GetStringIndex(BCC.Par.s);
+		else switch (BCC.bccType)
+		{
+		case AB_CPROPLIST: case AB_CARRAY: case AB_CFUNCTION:
+		{
+			C4V_Type eConstType = BCC.bccType == AB_CPROPLIST ? C4V_PropList : BCC.bccType == AB_CARRAY ? C4V_Array : C4V_Function;
+			Out_Chunk.Par = GetConstantIndex(eConstType, reinterpret_cast<const void *>(BCC.Par.X));
+			if (Out_Chunk.Par < 0) return false;
+			break;
+		}
+		case AB_FUNC:
+		{
+			// the compiler resolved the callee in one of these ways
+			C4AulFunc *pCallee = BCC.Par.f;
+			C4String *pName = ::Strings.FindString(pCallee->GetName());
+			if (!pName) return false;
+			int32_t iKind;
+			if (pCallee == pFunc->OwnerOverloaded)
+				iKind = C4AulCodeCache_FuncOverloaded;
+			else if (pFunc->Parent && pFunc->Parent->GetFunc(pName) == pCallee)
+				iKind = C4AulCodeCache_FuncLocal;
+			else if (pEngine->GetFunc(pName) == pCallee)
+				iKind = C4AulCodeCache_FuncGlobal;
+			else
+				return false;
+			Out_Chunk.Par = (GetStringIndex(pName) << 2) | iKind;
+			break;
+		}
+		case AB_ERR:
+			return false;
+		default:
+			Out_Chunk.Par = BCC.Par.i;
+			break;
+		}
+		const char *szPos = pFunc->PosForCode[i];
+		if (!szPos)
+			Out_Chunk.Pos = -1;
+		else if (szPos >= szScript && szPos <= szScript + iScriptLength)
+			Out_Chunk.Pos = szPos - szScript;
+		else
+			return false;
+	}
+	return true;
+}
+
+bool C4AulCodeCache::DecodeFunction(const Function &Cached, C4AulScriptFunc *pFunc) const
+{
+	size_t iScriptLength = 0;
+	const char *szScript = GetScriptBase(pFunc, &iScriptLength);
+	if (!szScript) return false;
+	std::vector<C4AulBCC> Code;
+	std::vector<const char *> PosForCode;
+	Code.reserve(Cached.Code.size());
+	PosForCode.reserve(Cached.Code.size());
+	for (const Chunk &In : Cached.Code)
+	{
+		if (In.Type < 0 || In.Type > AB_EOFN) return false;
+		C4AulBCCType eType = static_cast<C4AulBCCType>(In.Type);
+		intptr_t X;
+		if (IsStringChunk(eType))
+		{
+			if (!Inside<int32_t>(In.Par, 0, CachedStrings.size() - 1)) return false;
+			X = reinterpret_cast<intptr_t>(static_cast<const C4String *>(CachedStrings[In.Par]));
+		}
+		else switch (eType)
+		{
+		case AB_CPROPLIST: case AB_CARRAY: case AB_CFUNCTION:
+		{
+			if (!Inside<int32_t>(In.Par, 0, pEngine->GlobalConstNames.iSize - 1)) return false;
+			const C4Value &Value = pEngine->GlobalConsts[In.Par];
+			if (eType == AB_CPROPLIST && Value.GetType() == C4V_PropList)
+				X = reinterpret_cast<intptr_t>(Value._getPropList());
+			else if (eType == AB_CARRAY && Value.GetType() == C4V_Array)
+				X = reinterpret_cast<intptr_t>(Value._getArray());
+			else if (eType == AB_CFUNCTION && Value.GetType() == C4V_Function)
+				X = reinterpret_cast<intptr_t>(Value._getFunction());
+			else
+				return false;
+			break;
+		}
+		case AB_FUNC:
+		{
+			int32_t iName = In.Par >> 2;
+			if (!Inside<int32_t>(iName, 0, CachedStrings.size() - 1)) return false;
+			C4String *pName = const_cast<C4String *>(static_cast<const C4String *>(CachedStrings[iName]));
+			C4AulFunc *pCallee = nullptr;
+			switch (In.Par & 3)
+			{
+			case C4AulCodeCache_FuncOverloaded: pCallee = pFunc->OwnerOverloaded; break;
+			case C4AulCodeCache_FuncLocal: pCallee = pFunc->Parent ? pFunc->Parent->GetFunc(pName) : nullptr; break;
+			case C4AulCodeCache_FuncGlobal: pCallee = pEngine->GetFunc(pName); break;
+			}
+			if (!pCallee || !SEqual(pCallee->GetName(), pName->GetCStr())) return false;
+			X = reinterpret_cast<intptr_t>(pCallee);
+			break;
+		}
+		case AB_ERR:
+			return false;
+		default:
+			X = In.Par;
+			break;
+		}
+		if (In.Pos == -1)
+			PosForCode.push_back(nullptr);
+		else if (Inside<int32_t>(In.Pos, 0, iScriptLength))
+			PosForCode.push_back(szScript + In.Pos);
+		else
+			return false;
+		Code.emplace_back(eType, X);
+	}
+	pFunc->ClearCode();
+	pFunc->Code = std::move(Code);
+	pFunc->PosForCode = std::move(PosForCode);
+	return true;
+}
+
+void C4AulCodeCache::Begin(C4AulScriptEngine *pForEngine)
+{
+	pEngine = pForEngine;
+	iRestoredCount = 0;
+	// anything changed since the cache was written?
+	StdCopyStrBuf NewKey = CalculateKey();
+	size_t iHostCount = 0;
+	HostIndices.clear();
+	for (C4ScriptHost *pHost = pEngine->Child0; pHost; pHost = pHost->Next)
+		HostIndices[pHost] = iHostCount++;
+	if (NewKey != Key || Hosts.size() != iHostCount)
+	{
+		Key = NewKey;
+		Hosts.clear();
+		Hosts.resize(iHostCount);
+		fChanged = true;
+	}
+}
+
+void C4AulCodeCache::End()
+{
+	Mode = CM_None;
+	pCurrent = nullptr;
+	CachedStrings.clear();
+	if (fChanged && pEngine)
+	{
+		StdBuf Buf = DecompileToBuf<StdCompilerBinWrite>(*this);
+		if (Buf.SaveToFile(Filename.getData()))
+			fChanged = false;
+	}
+	pEngine = nullptr;
+}
+
+void C4AulCodeCache::BeginHost(C4ScriptHost *pHost)
+{
+	Mode = CM_None;
+	auto i = HostIndices.find(pHost);
+	if (!pEngine || i == HostIndices.end()) return;
+	pCurrent = pHost;
+	iCurrentIndex = i->second;
+	iNextFunction = 0;
+	const Host &Cached = Hosts[iCurrentIndex];
+	if (Cached.Valid && Cached.ScriptName == pHost->ScriptName)
+	{
+		Mode = CM_Restore;
+		CachedStrings.clear();
+		CachedStrings.reserve(Cached.Strings.size());
+		for (const StdCopyStrBuf &Str : Cached.Strings)
+			CachedStrings.emplace_back(::Strings.RegString(Str));
+	}
+	else
+	{
+		Mode = CM_Record;
+		Recording = Host();
+		Recording.ScriptName.Copy(pHost->ScriptName);
+		RecordedStrings.clear();
+	}
+}
+
+void C4AulCodeCache::EndHost(bool fClean)
+{
+	if (Mode == CM_None) return;
+	Host &Cached = Hosts[iCurrentIndex];
+	if (Mode == CM_Restore && fClean && iNextFunction == Cached.Functions.size())
+	{
+		// everything matched; keep the entry
+	}
+	else if (Mode == CM_Record && fClean)
+	{
+		Recording.Valid = true;
+		Cached = std::move(Recording);
+		fChanged = true;
+	}
+	else if (Cached.Valid)
+	{
+		// compile this one normally next time
+		Cached = Host();
+		fChanged = true;
+	}
+	Recording = Host();
+	RecordedStrings.clear();
+	CachedStrings.clear();
+	Mode = CM_None;
+	pCurrent = nullptr;
+}
+
+bool C4AulCodeCache::RestoreFunction(C4AulScriptFunc *pFunc)
+{
+	if (Mode != CM_Restore) return false;
+	const Host &Cached = Hosts[iCurrentIndex];
+	if (iNextFunction < Cached.Functions.size())
+	{
+		const Function &Func = Cached.Functions[iNextFunction];
+		if (Func.Name == pFunc->GetName() && DecodeFunction(Func, pFunc))
+		{
+			++iNextFunction;
+			++iRestoredCount;
+			return true;
+		}
+	}
+	// out of sync: generate the rest of the host and drop it from the cache
+	Mode = CM_Failed;
+	return false;
+}
+
+void C4AulCodeCache::StoreFunction(C4AulScriptFunc *pFunc)
+{
+	if (Mode != CM_Record) return;
+	Recording.Functions.emplace_back();
+	if (!EncodeFunction(pFunc, Recording.Functions.back()))
+		Mode = CM_Failed;
+}
@@ -0,0 +1,107 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Keeps generated byte code between engine runs.
+
+   The cache is a file holding the byte code of every function generated in
+   C4AulScriptEngine::Link, with all pointers replaced by names and indices.
+   It is keyed by the engine version, the name and text of every script host
+   in link order, and the global names and constants the compiler resolves
+   identifiers against. If any of these differ, all code is generated anew
+   and the file is rewritten afterwards.
+
+   Scripts are still parsed and preparsed as usual, because that is what
+   creates the functions, constants and include graph. On a cache hit, the
+   compiler takes each function's code from the cache instead of walking
+   its syntax tree. Hosts whose compilation produced warnings or errors are
+   never cached, so these are reported on every start. */
+
+#ifndef INC_C4AulCodeCache
+#define INC_C4AulCodeCache
+
+#include "script/C4StringTable.h"
+#include "script/C4Value.h"
+
+class C4AulCodeCache
+{
+public:
+	C4AulCodeCache(const char *szFilename, const char *szEngineVersion);
+
+	// Byte code chunk with its parameter as a plain value
+	struct Chunk
+	{
+		int32_t Type{0};
+		int32_t Par{0}; // index into Strings / GlobalConsts for pointer parameters, the value itself otherwise
+		int32_t Pos{-1}; // offset into the script of the function, -1 if none
+	};
+	struct Function
+	{
+		StdCopyStrBuf Name;
+		std::vector<Chunk> Code;
+		void CompileFunc(StdCompiler *pComp);
+	};
+	// Everything generated for one script host, in compilation order
+	struct Host
+	{
+		StdCopyStrBuf ScriptName;
+		bool Valid{false};
+		std::vector<StdCopyStrBuf> Strings;
+		std::vector<Function> Functions;
+		void CompileFunc(StdCompiler *pComp);
+	};
+
+private:
+	StdCopyStrBuf Filename, EngineVersion, Key;
+	std::vector<Host> Hosts; // in link order
+	std::map<const C4ScriptHost *, size_t> HostIndices;
+	C4AulScriptEngine *pEngine{nullptr};
+	bool fChanged{false};
+	int32_t iRestoredCount{0};
+
+	// host currently being compiled
+	enum { CM_None, CM_Restore, CM_Record, CM_Failed } Mode{CM_None};
+	C4ScriptHost *pCurrent{nullptr};
+	size_t iCurrentIndex{0};
+	size_t iNextFunction{0}; // CM_Restore: next function expected from the cache
+	std::vector<C4RefCntPointer<C4String> > CachedStrings; // CM_Restore: strings of the cached host
+	Host Recording; // CM_Record: code of the current host as it is compiled
+	std::map<C4String *, int32_t> RecordedStrings;
+
+	StdCopyStrBuf CalculateKey() const;
+	bool DecodeFunction(const Function &Cached, C4AulScriptFunc *pFunc) const;
+	bool EncodeFunction(C4AulScriptFunc *pFunc, Function &Out);
+	int32_t GetStringIndex(C4String *pStr);
+	int32_t GetConstantIndex(C4V_Type eType, const void *pData) const;
+	static const char *GetScriptBase(const C4AulScriptFunc *pFunc, size_t *piLength);
+
+public:
+	void CompileFunc(StdCompiler *pComp);
+
+	// Called around all compilation in C4AulScriptEngine::Link
+	void Begin(C4AulScriptEngine *pForEngine);
+	void End();
+
+	// Called by C4ScriptHost::Parse around compiling a host; fClean if there were no warnings or errors
+	void BeginHost(C4ScriptHost *pHost);
+	void EndHost(bool fClean);
+
+	// Called by the compiler for each function it generates code for
+	bool RestoreFunction(C4AulScriptFunc *pFunc); // true if the code was taken from the cache
+	void StoreFunction(C4AulScriptFunc *pFunc);
+
+	int32_t GetRestoredCount() const { return iRestoredCount; } // functions taken from the cache in the last Link
+};
+
+#endif
@@ -18,6 +18,7 @@
 #include "script/C4AulCompiler.h"
 
 #include "script/C4Aul.h"
+#include "script/C4AulCodeCache.h"
 #include "script/C4AulParse.h"
 #include "script/C4AulScriptFunc.h"
 #include "script/C4ScriptHost.h"
@@ -180,7 +181,8 @@ class C4AulCompiler::CodegenAstVisitor : public ::aul::DefaultRecursiveVisitor
 	
 	constexpr static bool IsJump(C4AulBCCType t)
 	{
-		return t == AB_JUMP || t == AB_JUMPAND || t == AB_JUMPOR || t == AB_JUMPNNIL || t == AB_CONDN || t == AB_COND;
+		return t == AB_JUMP || t == AB_JUMPAND || t == AB_JUMPOR || t == AB_JUMPNNIL || t == AB_CONDN || t == AB_COND ||
+			(t >= AB_CONDN_LessThan && t <= AB_CONDN_NotEqual);
 	}
 
 	int AddJumpTarget();
@@ -703,6 +705,17 @@ int C4AulCompiler::CodegenAstVisitor::GetStackValue(C4AulBCCType eType, intptr_t
 	case AB_STACK:
 		return X;
 
+	case AB_DUP2:
+		return 2;
+
+	case AB_CONDN_LessThan:
+	case AB_CONDN_LessThanEqual:
+	case AB_CONDN_GreaterThan:
+	case AB_CONDN_GreaterThanEqual:
+	case AB_CONDN_Equal:
+	case AB_CONDN_NotEqual:
+		return -2;
+
 	case AB_NEW_ARRAY:
 		return -X + 1;
 
@@ -829,6 +842,27 @@ int C4AulCompiler::CodegenAstVisitor::AddBCC(const char *TokenSPos, C4AulBCCType
 			pCPos1->Par.i *= -1;
 			return Fn->GetCodePos() - 1;
 		}
+
+		// Join two AB_DUPs to AB_DUP2 (the usual way to load both operands of a binary operator)
+		if (eType == AB_DUP && pCPos1->bccType == AB_DUP &&
+			Inside<intptr_t>(pCPos1->Par.i, INT16_MIN, INT16_MAX) && Inside<intptr_t>(X, INT16_MIN, INT16_MAX))
+		{
+			int16_t iFirst = pCPos1->Par.i;
+			pCPos1->bccType = AB_DUP2;
+			pCPos1->Par.X = 0;
+			pCPos1->Par.i2[0] = iFirst;
+			pCPos1->Par.i2[1] = static_cast<int16_t>(X);
+			return Fn->GetCodePos() - 1;
+		}
+
+		// Join comparison + AB_CONDN to a single conditional jump
+		static_assert(AB_CONDN_NotEqual - AB_CONDN_LessThan == AB_NotEqual - AB_LessThan, "comparison jumps out of order");
+		if (eType == AB_CONDN && pCPos1->bccType >= AB_LessThan && pCPos1->bccType <= AB_NotEqual)
+		{
+			pCPos1->bccType = C4AulBCCType(AB_CONDN_LessThan + (pCPos1->bccType - AB_LessThan));
+			pCPos1->Par.i = X + 1;
+			return Fn->GetCodePos() - 1;
+		}
 	}
 
 	// Add
@@ -859,6 +893,15 @@ int C4AulCompiler::CodegenAstVisitor::AddBCC(const char *SPos, const C4AulBCC &b
 C4AulBCC C4AulCompiler::CodegenAstVisitor::MakeSetter(const char *SPos, bool fLeaveValue)
 {
 	assert(Fn);
+	// Split AB_DUP2 so that only the second value is assigned to
+	C4AulBCC *pLast = Fn->GetLastCode();
+	if (pLast->bccType == AB_DUP2)
+	{
+		int32_t iSecond = pLast->Par.i2[1];
+		pLast->bccType = AB_DUP;
+		pLast->Par.X = pLast->Par.i2[0];
+		Fn->AddBCC(AB_DUP, iSecond, SPos);
+	}
 	C4AulBCC Value = *(Fn->GetLastCode()), Setter = Value;
 	// Check type
 	switch (Value.bccType)
@@ -1512,6 +1555,11 @@ void C4AulCompiler::CodegenAstVisitor::EmitFunctionCode(const ::aul::ast::Functi
 {
 	assert(Fn != nullptr);
 
+	// Take previously generated code if nothing changed since
+	C4AulCodeCache *cache = target_host ? target_host->Engine->GetCodeCache() : nullptr;
+	if (cache && cache->RestoreFunction(Fn))
+		return;
+
 	Fn->ClearCode();
 
 	// Reserve var stack space
@@ -1542,6 +1590,8 @@ void C4AulCompiler::CodegenAstVisitor::EmitFunctionCode(const ::aul::ast::Functi
 	// case.
 	AddBCC(n->loc, AB_EOFN);
 	assert(stack_height == 0);
+	if (cache)
+		cache->StoreFunction(Fn);
 }
 
 void C4AulCompiler::CodegenAstVisitor::visit(const ::aul::ast::DoLoop *n)
@@ -27,6 +27,7 @@
 #include "script/C4ScriptHost.h"
 
 C4AulExec AulExec;
+C4AulSampler AulSampler;
 
 C4AulExecError::C4AulExecError(const char *szError)
 {
@@ -147,6 +148,9 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4PropList * p, C4Value *pnPars
 	// Save start context
 	C4AulScriptContext *pOldCtx = pCurCtx;
 	C4Value *pPars = pCurVal + 1;
+	// Samples requested while no script was running belong to the engine
+	if (pCurCtx < Contexts && AulSampler.IsPending())
+		AulSampler.Sample(nullptr, nullptr, nullptr);
 	try
 	{
 		// Push parameters
@@ -197,6 +201,9 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 
 		for (;;)
 		{
+			// Sampling profiler
+			if (AulSampler.IsPending())
+				AulSampler.Sample(Contexts, pCurCtx, nullptr);
 
 			bool fJump = false;
 			switch (pCPos->bccType)
@@ -232,6 +239,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 			case AB_DUP:
 				PushValue(pCurVal[pCPos->Par.i]);
 				break;
+			case AB_DUP2:
+				PushValue(pCurVal[pCPos->Par.i2[0]]);
+				PushValue(pCurVal[pCPos->Par.i2[1]]);
+				break;
 			case AB_STACK_SET:
 				pCurVal[pCPos->Par.i] = pCurVal[0];
 				break;
@@ -257,7 +268,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				if (!pCurCtx->Obj)
 					throw C4AulExecError("can't access local variables without this");
 				PushNullVals(1);
-				pCurCtx->Obj->GetPropertyByS(pCPos->Par.s, pCurVal);
+				pCurCtx->Obj->GetPropertyByS(pCPos->Par.s, pCurVal, pCurCtx->Func->GetPropertyCache(pCPos));
 				break;
 			case AB_LOCALN_SET:
 				if (!pCurCtx->Obj)
@@ -270,7 +281,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 			case AB_PROP:
 				if (!pCurVal->CheckConversion(C4V_PropList))
 					throw C4AulExecError(FormatString("proplist access: proplist expected, got %s", pCurVal->GetTypeName()).getData());
-				if (!pCurVal->_getPropList()->GetPropertyByS(pCPos->Par.s, pCurVal))
+				if (!pCurVal->_getPropList()->GetPropertyByS(pCPos->Par.s, pCurVal, pCurCtx->Func->GetPropertyCache(pCPos)))
 					pCurVal->Set0();
 				break;
 			case AB_PROP_SET:
@@ -644,6 +655,60 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos)
 				PopValue();
 				break;
 
+			// comparison and AB_CONDN in one
+			case AB_CONDN_LessThan:
+				CheckOpPars(C4V_Int, C4V_Int, "<");
+				if (!(pCurVal[-1]._getInt() < pCurVal[0]._getInt()))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+			case AB_CONDN_LessThanEqual:
+				CheckOpPars(C4V_Int, C4V_Int, "<=");
+				if (!(pCurVal[-1]._getInt() <= pCurVal[0]._getInt()))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+			case AB_CONDN_GreaterThan:
+				CheckOpPars(C4V_Int, C4V_Int, ">");
+				if (!(pCurVal[-1]._getInt() > pCurVal[0]._getInt()))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+			case AB_CONDN_GreaterThanEqual:
+				CheckOpPars(C4V_Int, C4V_Int, ">=");
+				if (!(pCurVal[-1]._getInt() >= pCurVal[0]._getInt()))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+			case AB_CONDN_Equal:
+				if (!pCurVal[-1].IsIdenticalTo(pCurVal[0]))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+			case AB_CONDN_NotEqual:
+				if (pCurVal[-1].IsIdenticalTo(pCurVal[0]))
+				{
+					fJump = true;
+					pCPos += pCPos->Par.i;
+				}
+				PopValues(2);
+				break;
+
 			case AB_RETURN:
 			{
 				// Trace
@@ -892,6 +957,9 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 #ifdef _DEBUG
 		assert(pCtx == pCurCtx);
 #endif
+		// Samples requested during the call were spent in the engine function
+		if (AulSampler.IsPending())
+			AulSampler.Sample(Contexts, pCurCtx, pFunc);
 
 		// Remove parameters from stack
 		PopValuesUntil(pReturn);
@@ -1010,6 +1078,80 @@ void C4AulProfiler::Show()
 	// done!
 }
 
+void C4AulSampler::Start(uint32_t iIntervalUS)
+{
+	Stop();
+	Stacks.clear();
+	iSampleCount = 0;
+	iPending = 0;
+	fStop = false;
+	Timer = std::thread(&C4AulSampler::TimerMain, this, std::max<uint32_t>(iIntervalUS, 1));
+}
+
+void C4AulSampler::Stop()
+{
+	if (!IsRunning()) return;
+	{
+		std::lock_guard<std::mutex> Lock(Mutex);
+		fStop = true;
+	}
+	StopRequest.notify_all();
+	Timer.join();
+	// whatever is still pending was not spent in script
+	Sample(nullptr, nullptr, nullptr);
+}
+
+void C4AulSampler::TimerMain(uint32_t iIntervalUS)
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	auto tNext = std::chrono::steady_clock::now();
+	for (;;)
+	{
+		tNext += std::chrono::microseconds(iIntervalUS);
+		if (StopRequest.wait_until(Lock, tNext, [this] { return fStop; })) return;
+		iPending.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void C4AulSampler::Sample(const C4AulScriptContext *pFirst, const C4AulScriptContext *pLast, const C4AulFunc *pEngineFunc)
+{
+	uint32_t iCount = iPending.exchange(0, std::memory_order_relaxed);
+	if (!iCount) return;
+	std::string Stack;
+	if (pFirst)
+		for (const C4AulScriptContext *pCtx = pFirst; pCtx <= pLast; ++pCtx)
+		{
+			if (!Stack.empty()) Stack += ';';
+			Stack += pCtx->Func ? pCtx->Func->GetFullName().getData() : "(unknown)";
+		}
+	if (pEngineFunc)
+	{
+		if (!Stack.empty()) Stack += ';';
+		Stack += pEngineFunc->GetName();
+	}
+	if (Stack.empty()) Stack = "(engine)";
+	Stacks[Stack] += iCount;
+	iSampleCount += iCount;
+}
+
+StdStrBuf C4AulSampler::GetCollapsedStacks() const
+{
+	// sorted for stable output
+	std::vector<const std::pair<const std::string, uint32_t> *> Sorted;
+	Sorted.reserve(Stacks.size());
+	for (const auto &Stack : Stacks) Sorted.push_back(&Stack);
+	std::sort(Sorted.begin(), Sorted.end(), [](const auto *a, const auto *b) { return a->first < b->first; });
+	StdStrBuf Result;
+	for (const auto *pStack : Sorted)
+		Result.AppendFormat("%s %u\n", pStack->first.c_str(), pStack->second);
+	return Result;
+}
+
+bool C4AulSampler::Save(const char *szFilename) const
+{
+	return GetCollapsedStacks().SaveToFile(szFilename);
+}
+
 C4Value C4AulExec::DirectExec(C4PropList *p, const char *szScript, const char *szContext, bool fPassErrors, C4AulScriptContext* context, bool parse_function)
 {
 	if (DEBUGREC_SCRIPT && Config.General.DebugRec)
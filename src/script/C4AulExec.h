@@ -23,6 +23,11 @@
 #include "script/C4Aul.h"
 #include "script/C4AulScriptFunc.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 const int MAX_CONTEXT_STACK = 512;
 const int MAX_VALUE_STACK = 1024;
 
@@ -259,4 +264,38 @@ public:
 	static void StopProfiling(); // stop the profiler and displays results
 };
 
+// sampling script profiler
+// A timer thread periodically requests a sample. The script engine takes it at the next
+// bytecode or when an engine function returns, recording the whole context stack. Stacks
+// are counted in flamegraph ("collapsed") format: Frames separated by ';', then the count.
+class C4AulSampler
+{
+private:
+	std::thread Timer;
+	std::mutex Mutex;
+	std::condition_variable StopRequest;
+	bool fStop{false};
+	std::atomic<uint32_t> iPending{0}; // samples requested by the timer but not taken yet
+	uint32_t iSampleCount{0};
+	std::unordered_map<std::string, uint32_t> Stacks;
+
+	void TimerMain(uint32_t iIntervalUS);
+public:
+	C4AulSampler() = default;
+	~C4AulSampler() { Stop(); }
+
+	bool IsRunning() const { return Timer.joinable(); }
+	bool IsPending() const { return iPending.load(std::memory_order_relaxed) != 0; }
+	uint32_t GetSampleCount() const { return iSampleCount; }
+
+	void Start(uint32_t iIntervalUS); // discard previous samples and start taking new ones
+	void Stop();
+	// take the pending samples for the given context stack and engine function (both optional)
+	void Sample(const C4AulScriptContext *pFirst, const C4AulScriptContext *pLast, const C4AulFunc *pEngineFunc);
+	StdStrBuf GetCollapsedStacks() const;
+	bool Save(const char *szFilename) const;
+};
+
+extern C4AulSampler AulSampler;
+
 #endif // C4AULEXEC_H
@@ -17,6 +17,7 @@
 
 #include "C4Include.h"
 #include "script/C4Aul.h"
+#include "script/C4AulCodeCache.h"
 
 #include "game/C4Game.h"
 #include "landscape/C4Material.h"
@@ -175,6 +176,7 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 			s->ResolveIncludes(rDefs);
 
 		// parse the scripts to byte code
+		if (CodeCache) CodeCache->Begin(this);
 		for (C4ScriptHost *s = Child0; s; s = s->Next)
 			s->Parse();
 
@@ -195,6 +197,7 @@ void C4AulScriptEngine::Link(C4DefList *rDefs)
 		// error??! show it!
 		ErrorHandler->OnError(err.what());
 	}
+	if (CodeCache) CodeCache->End();
 
 	// Set name list for globals (FIXME: is this necessary?)
 	ScriptEngine.GlobalNamed.SetNameList(&ScriptEngine.GlobalNamedNames);
@@ -19,6 +19,7 @@
 #include "script/C4AulParse.h"
 
 #include "object/C4Def.h"
+#include "script/C4AulCodeCache.h"
 #include "script/C4AulDebug.h"
 #include "script/C4AulExec.h"
 
@@ -588,6 +589,7 @@ static const char * GetTTName(C4AulBCCType e)
 	case AB_NIL: return "NIL";    // constant: nil
 	case AB_NEW_ARRAY: return "NEW_ARRAY";    // semi-constant: array
 	case AB_DUP: return "DUP";    // duplicate value from stack
+	case AB_DUP2: return "DUP2";  // two DUPs in a row
 	case AB_DUP_CONTEXT: return "AB_DUP_CONTEXT"; // duplicate value from stack of parent function
 	case AB_NEW_PROPLIST: return "NEW_PROPLIST";    // create a new proplist
 	case AB_POP_TO: return "POP_TO";    // initialization of named var
@@ -597,6 +599,12 @@ static const char * GetTTName(C4AulBCCType e)
 	case AB_JUMPNNIL: return "JUMPNNIL"; // nil-coalescing operator ("??")
 	case AB_CONDN: return "CONDN";    // conditional jump (negated, pops stack)
 	case AB_COND: return "COND";    // conditional jump (pops stack)
+	case AB_CONDN_LessThan: return "CONDN_LessThan"; // comparison and conditional jump
+	case AB_CONDN_LessThanEqual: return "CONDN_LessThanEqual";
+	case AB_CONDN_GreaterThan: return "CONDN_GreaterThan";
+	case AB_CONDN_GreaterThanEqual: return "CONDN_GreaterThanEqual";
+	case AB_CONDN_Equal: return "CONDN_Equal";
+	case AB_CONDN_NotEqual: return "CONDN_NotEqual";
 	case AB_FOREACH_NEXT: return "FOREACH_NEXT"; // foreach: next element
 	case AB_RETURN: return "RETURN";  // return statement
 	case AB_ERR: return "ERR";      // parse error at this position
@@ -618,6 +626,8 @@ void C4AulScriptFunc::DumpByteCode()
 			switch (bcc.bccType)
 			{
 			case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_JUMPNNIL: case AB_CONDN: case AB_COND:
+			case AB_CONDN_LessThan: case AB_CONDN_LessThanEqual: case AB_CONDN_GreaterThan:
+			case AB_CONDN_GreaterThanEqual: case AB_CONDN_Equal: case AB_CONDN_NotEqual:
 				labels[&bcc + bcc.Par.i] = ++labeln; break;
 			default: break;
 			}
@@ -681,7 +691,11 @@ void C4AulScriptFunc::DumpByteCode()
 			case AB_CPROPLIST:
 				fprintf(stderr, "\t%s\n", C4VPropList(bcc.Par.p).GetDataString().getData()); break;
 			case AB_JUMP: case AB_JUMPAND: case AB_JUMPOR: case AB_JUMPNNIL: case AB_CONDN: case AB_COND:
+			case AB_CONDN_LessThan: case AB_CONDN_LessThanEqual: case AB_CONDN_GreaterThan:
+			case AB_CONDN_GreaterThanEqual: case AB_CONDN_Equal: case AB_CONDN_NotEqual:
 				fprintf(stderr, "\t% -d\n", labels[&bcc + bcc.Par.i]); break;
+			case AB_DUP2:
+				fprintf(stderr, "\t% -d\t% -d\n", bcc.Par.i2[0], bcc.Par.i2[1]); break;
 			default:
 				fprintf(stderr, "\t% -d\n", bcc.Par.i); break;
 			}
@@ -720,7 +734,7 @@ bool C4ScriptHost::Preparse()
 	IncludesResolved = false;
 
 	// Parse will write the properties back after the ones from included scripts
-	GetPropList()->Properties.Swap(&LocalValues);
+	GetPropList()->MovePropertiesTo(LocalValues);
 
 	// return success
 	this->State = ASS_PREPARSED;
@@ -1727,7 +1741,9 @@ void C4ScriptHost::CopyPropList(C4Set<C4Property> & from, C4PropListStatic * to)
 					if (!p || p->GetParent() != to)
 					{
 						p = C4PropList::NewStatic(nullptr, to, prop->Key);
-						CopyPropList(prop->Value._getPropList()->Properties, p);
+						C4Set<C4Property> Nested;
+						prop->Value._getPropList()->CopyPropertiesTo(Nested);
+						CopyPropList(Nested, p);
 					}
 				to->SetPropertyByS(prop->Key, C4VPropList(p));
 			}
@@ -1764,9 +1780,13 @@ bool C4ScriptHost::Parse()
 			GetPropList()->GetDef()->IncludeDefinition(SourceScript->GetPropList()->GetDef());
 	}
 
-	// generate bytecode
+	// generate bytecode, or take it from the cache if this script compiled cleanly before
+	C4AulCodeCache *pCache = Engine->GetCodeCache();
+	int iPrevWarnCnt = Engine->warnCnt, iPrevErrCnt = Engine->errCnt;
+	if (pCache) pCache->BeginHost(this);
 	for (auto &s : SourceScripts)
 		C4AulCompiler::Compile(this, s, s->ast.get());
+	if (pCache) pCache->EndHost(Engine->warnCnt == iPrevWarnCnt && Engine->errCnt == iPrevErrCnt);
 
 	// save line count
 	Engine->lineCnt += SGetLine(Script.getData(), Script.getPtr(Script.getLength()));
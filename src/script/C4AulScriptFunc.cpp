@@ -76,6 +76,7 @@ void C4AulScriptFunc::ClearCode()
 {
 	while(Code.size() > 0)
 		RemoveLastBCC();
+	PropertyCaches.clear();
 	// This function is now broken until an AddBCC call
 }
 
@@ -16,6 +16,7 @@
 #ifndef C4AULSCRIPTFUNC_H_
 #define C4AULSCRIPTFUNC_H_
 
+#include "script/C4PropList.h"
 #include "script/C4Value.h"
 #include "script/C4ValueMap.h"
 
@@ -30,6 +31,7 @@ enum C4AulBCCType : int
 	AB_ARRAY_SLICE, // array slicing
 	AB_ARRAY_SLICE_SET,
 	AB_DUP,     // duplicate value from stack
+	AB_DUP2,    // two DUPs in a row
 	AB_DUP_CONTEXT, // duplicate value from stack of parent function
 	AB_STACK_SET, // copy top of stack to stack
 	AB_POP_TO,   // pop top of stack to stack
@@ -85,6 +87,12 @@ enum C4AulBCCType : int
 	AB_JUMPNNIL, // jump if not nil, else pop the stack
 	AB_CONDN,   // conditional jump (negated, pops stack)
 	AB_COND,    // conditional jump (pops stack)
+	AB_CONDN_LessThan, // comparison and conditional jump if it fails (pops both operands)
+	AB_CONDN_LessThanEqual,
+	AB_CONDN_GreaterThan,
+	AB_CONDN_GreaterThanEqual,
+	AB_CONDN_Equal,
+	AB_CONDN_NotEqual,
 	AB_FOREACH_NEXT, // foreach: next element
 	AB_RETURN,  // return statement
 	AB_ERR,     // parse error at this position
@@ -97,10 +105,12 @@ class C4AulBCC
 {
 public:
 	C4AulBCCType bccType{AB_EOFN}; // chunk type
+	int32_t iCache{0}; // AB_PROP / AB_LOCALN: 1 + index into the function's PropertyCaches, 0 if none yet
 	union
 	{
 		intptr_t X;
 		int32_t i;
+		int16_t i2[2]; // AB_DUP2
 		C4String * s;
 		C4PropList * p;
 		C4ValueArray * a;
@@ -111,11 +121,13 @@ public:
 	{
 		IncRef();
 	}
+	// caches belong to the function, so they are never taken along
 	C4AulBCC(const C4AulBCC & from): C4AulBCC(from.bccType, from.Par.X) { }
 	C4AulBCC & operator = (const C4AulBCC & from)
 	{
 		DecRef();
 		bccType = from.bccType;
+		iCache = 0;
 		Par = from.Par;
 		IncRef();
 		return *this;
@@ -128,6 +140,7 @@ public:
 	{
 		DecRef();
 		bccType = from.bccType;
+		iCache = 0;
 		Par = from.Par;
 		from.bccType = AB_EOFN;
 		return *this;
@@ -186,6 +199,7 @@ protected:
 	void DumpByteCode();
 	std::vector<C4AulBCC> Code;
 	std::vector<const char *> PosForCode;
+	std::vector<C4PropertyCache> PropertyCaches; // inline caches of property reads in Code
 	int ParCount;
 	C4V_Type ParType[C4AUL_MAX_Par]; // parameter types
 
@@ -218,12 +232,22 @@ public:
 
 	int GetLineOfCode(C4AulBCC * bcc);
 	C4AulBCC * GetCode();
+	C4PropertyCache &GetPropertyCache(C4AulBCC *pBCC)
+	{
+		if (!pBCC->iCache)
+		{
+			PropertyCaches.emplace_back();
+			pBCC->iCache = PropertyCaches.size();
+		}
+		return PropertyCaches[pBCC->iCache - 1];
+	}
 
 	uint32_t tProfileTime; // internally set by profiler
 
 	friend class C4AulCompiler;
 	friend class C4AulParse;
 	friend class C4ScriptHost;
+	friend class C4AulCodeCache;
 };
 
 #endif /* C4AULSCRIPTFUNC_H_ */
@@ -651,6 +651,19 @@ bool C4Effect::GetPropertyByS(const C4String *k, C4Value *pResult) const
 	return C4PropListNumbered::GetPropertyByS(k, pResult);
 }
 
+bool C4Effect::IsReflectedProperty(const C4String *k) const
+{
+	// keep in sync with GetPropertyByS
+	if (k >= &Strings.P[0] && k < &Strings.P[P_LAST])
+	{
+		switch(k - &Strings.P[0])
+		{
+			case P_Priority: case P_Interval: case P_CommandTarget: case P_Target: case P_Time: return true;
+		}
+	}
+	return C4PropListNumbered::IsReflectedProperty(k);
+}
+
 C4ValueArray * C4Effect::GetProperties() const
 {
 	C4ValueArray * a = C4PropList::GetProperties();
@@ -273,8 +273,9 @@ const char *C4PropListStatic::GetName() const
 }
 
 C4PropList::C4PropList(C4PropList * prototype):
-		prototype(prototype)
+		Shape(C4PropListShape::GetEmpty()), prototype(prototype)
 {
+	Shape->IncRef();
 #ifdef _DEBUG
 	PropLists.Add(this);
 #endif
@@ -309,7 +310,8 @@ C4PropListStatic *C4PropList::FreezeAndMakeStaticRecursively(std::vector<C4Value
 	{
 		// Make self static by creating a copy and replacing all references
 		this_static = NewStatic(GetPrototype(), parent, key);
-		this_static->Properties.Swap(&Properties); // grab properties
+		this_static->SwapProperties(this); // grab properties
+		this_static->PropertiesChanged();
 		this_static->Status = Status;
 		C4Value holder = C4VPropList(this);
 		while (FirstRef && FirstRef->NextRef)
@@ -349,12 +351,8 @@ C4PropListStatic *C4PropList::FreezeAndMakeStaticRecursively(std::vector<C4Value
 
 void C4PropList::Denumerate(C4ValueNumbers * numbers)
 {
-	const C4Property * p = Properties.First();
-	while (p)
-	{
-		const_cast<C4Value &>(p->Value).Denumerate(numbers);
-		p = Properties.Next(p);
-	}
+	for (C4Value &Value : Values)
+		Value.Denumerate(numbers);
 	prototype.Denumerate(numbers);
 	RemoveCyclicPrototypes();
 }
@@ -369,6 +367,8 @@ C4PropList::~C4PropList()
 		FirstRef = FirstRef->NextRef;
 		ref->NextRef = nullptr;
 	}
+	Values.clear();
+	Shape->DecRef();
 #ifdef _DEBUG
 	assert(PropLists.Has(this));
 	PropLists.Remove(this);
@@ -381,15 +381,13 @@ bool C4PropList::operator==(const C4PropList &b) const
 	// every numbered proplist has a unique number and is only identical to itself
 	if (this == &b) return true;
 	if (IsNumbered() || b.IsNumbered()) return false;
-	if (Properties.GetSize() != b.Properties.GetSize()) return false;
+	if (Values.size() != b.Values.size()) return false;
 	if (GetDef() != b.GetDef()) return false;
-	const C4Property * p = Properties.First();
-	while (p)
+	for (int32_t i = 0; i < Shape->GetSize(); ++i)
 	{
-		const C4Property & bp = b.Properties.Get(p->Key);
-		if (!bp) return false;
-		if (p->Value != bp.Value) return false;
-		p = Properties.Next(p);
+		const C4Value *pValue = b.GetOwnProperty(Shape->GetKey(i));
+		if (!pValue) return false;
+		if (Values[i] != *pValue) return false;
 	}
 	return true;
 }
@@ -416,15 +414,55 @@ void C4PropList::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 	else
 		pComp->Value(mkParAdapt(prototype, numbers));
 	pComp->Separator(StdCompiler::SEP_SEP2);
-	pComp->Value(mkParAdapt(Properties, numbers));
-	if (oldFormat)
+	// same format as a C4Set<C4Property>
+	bool fNaming = pComp->hasNaming();
+	if (pComp->isDeserializer())
 	{
-		if (Properties.Has(&::Strings.P[P_Prototype]))
+		ClearProperties();
+		uint32_t iSize;
+		if (!fNaming) pComp->Value(iSize);
+		do
 		{
-			prototype = Properties.Get(&::Strings.P[P_Prototype]).Value;
-			Properties.Remove(&::Strings.P[P_Prototype]);
+			if (!fNaming && !iSize--)
+				break;
+			try
+			{
+				C4Property e;
+				pComp->Value(mkParAdapt(e, numbers));
+				int32_t i = Shape->GetIndex(e.Key);
+				if (oldFormat && e.Key == &::Strings.P[P_Prototype])
+					prototype = e.Value;
+				else if (i >= 0)
+					Values[i] = e.Value;
+				else
+					AddProperty(e.Key, e.Value);
+			}
+			catch (StdCompiler::NotFoundException *pEx)
+			{
+				delete pEx;
+				break;
+			}
 		}
+		while (pComp->Separator(StdCompiler::SEP_SEP));
 	}
+	else
+	{
+		if (!fNaming)
+		{
+			int32_t iSize = Values.size();
+			pComp->Value(iSize);
+		}
+		for (int32_t i = 0; i < Shape->GetSize(); ++i)
+		{
+			// like C4Property::CompileFunc, but the value has to stay in place for C4ValueNumbers
+			StdStrBuf s = Shape->GetKey(i)->GetData();
+			pComp->Value(s);
+			pComp->Separator(StdCompiler::SEP_SET);
+			pComp->Value(mkParAdapt(Values[i], numbers));
+			if (i + 1 < Shape->GetSize()) pComp->Separator(StdCompiler::SEP_SEP);
+		}
+	}
+	PropertiesChanged();
 }
 
 void C4PropList::RemoveCyclicPrototypes()
@@ -518,7 +556,7 @@ void C4Property::CompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers)
 void C4PropList::AppendDataString(StdStrBuf * out, const char * delim, int depth, bool ignore_reference_parent) const
 {
 	StdStrBuf & DataString = *out;
-	if (depth <= 0 && Properties.GetSize())
+	if (depth <= 0 && !Values.empty())
 	{
 		DataString.Append("...");
 		return;
@@ -532,20 +570,19 @@ void C4PropList::AppendDataString(StdStrBuf * out, const char * delim, int depth
 		has_elements = true;
 	}
 	// Append other properties
-	std::list<const C4Property *> sorted_props = Properties.GetSortedListOfElementPointers();
-	for (std::list<const C4Property *>::const_iterator p = sorted_props.begin(); p != sorted_props.end(); ++p)
+	for (int32_t i : GetSortedPropertyIndices())
 	{
 		if (has_elements) DataString.Append(delim);
-		DataString.Append((*p)->Key->GetData());
+		DataString.Append(Shape->GetKey(i)->GetData());
 		DataString.Append(" = ");
-		DataString.Append((*p)->Value.GetDataString(depth - 1, ignore_reference_parent ? IsStatic() : nullptr));
+		DataString.Append(Values[i].GetDataString(depth - 1, ignore_reference_parent ? IsStatic() : nullptr));
 		has_elements = true;
 	}
 }
 
 StdStrBuf C4PropList::ToJSON(int depth, bool ignore_reference_parent) const
 {
-	if (depth <= 0 && Properties.GetSize())
+	if (depth <= 0 && !Values.empty())
 	{
 		throw new C4JSONSerializationError("maximum depth reached");
 	}
@@ -560,13 +597,12 @@ StdStrBuf C4PropList::ToJSON(int depth, bool ignore_reference_parent) const
 		has_elements = true;
 	}
 	// Append other properties
-	std::list<const C4Property *> sorted_props = Properties.GetSortedListOfElementPointers();
-	for (std::list<const C4Property *>::const_iterator p = sorted_props.begin(); p != sorted_props.end(); ++p)
+	for (int32_t i : GetSortedPropertyIndices())
 	{
 		if (has_elements) DataString.Append(",");
-		DataString.Append(C4Value((*p)->Key).ToJSON());
+		DataString.Append(C4Value(Shape->GetKey(i)).ToJSON());
 		DataString.Append(":");
-		DataString.Append((*p)->Value.ToJSON(depth - 1, ignore_reference_parent ? IsStatic() : nullptr));
+		DataString.Append(Values[i].ToJSON(depth - 1, ignore_reference_parent ? IsStatic() : nullptr));
 		has_elements = true;
 	}
 	DataString.Append("}");
@@ -576,11 +612,11 @@ StdStrBuf C4PropList::ToJSON(int depth, bool ignore_reference_parent) const
 std::vector< C4String * > C4PropList::GetSortedLocalProperties(bool add_prototype) const
 {
 	// return property list without descending into prototype
-	std::list<const C4Property *> sorted_props = Properties.GetSortedListOfElementPointers();
+	std::vector<int32_t> sorted_props = GetSortedPropertyIndices();
 	std::vector< C4String * > result;
 	result.reserve(sorted_props.size() + add_prototype);
 	if (add_prototype) result.push_back(&::Strings.P[P_Prototype]); // implicit prototype for every prop list
-	for (auto p : sorted_props) result.push_back(p->Key);
+	for (int32_t i : sorted_props) result.push_back(Shape->GetKey(i));
 	return result;
 }
 
@@ -589,20 +625,23 @@ std::vector< C4String * > C4PropList::GetSortedLocalProperties(const char *prefi
 	// return property list without descending into prototype
 	// ignore properties that have been overridden by proplist given in ignore_overridden or any of its prototypes up to and excluding this
 	std::vector< C4String * > result;
-	for (const C4Property *pp = Properties.First(); pp; pp = Properties.Next(pp))
-		if (pp->Key != &::Strings.P[P_Prototype])
-			if (!prefix || pp->Key->GetData().BeginsWith(prefix))
+	for (int32_t i = 0; i < Shape->GetSize(); ++i)
+	{
+		C4String *pKey = Shape->GetKey(i);
+		if (pKey != &::Strings.P[P_Prototype])
+			if (!prefix || pKey->GetData().BeginsWith(prefix))
 			{
 				// Override check
 				const C4PropList *check = ignore_overridden;
 				bool overridden = false;
 				if (check && check != this)
 				{
-					if (check->HasProperty(pp->Key)) { overridden = true; break; }
+					if (check->HasProperty(pKey)) { overridden = true; break; }
 					check = check->GetPrototype();
 				}
-				result.push_back(pp->Key);
+				result.push_back(pKey);
 			}
+	}
 	// Sort
 	std::sort(result.begin(), result.end(), [](const C4String *a, const C4String *b) -> bool
 	{
@@ -619,10 +658,13 @@ std::vector< C4String * > C4PropList::GetUnsortedProperties(const char *prefix,
 	const C4PropList *p = this;
 	do
 	{
-		for (const C4Property *pp = p->Properties.First(); pp; pp = p->Properties.Next(pp))
-			if (pp->Key != &::Strings.P[P_Prototype])
-				if (!prefix || pp->Key->GetData().BeginsWith(prefix))
-					result.push_back(pp->Key);
+		for (int32_t i = 0; i < p->Shape->GetSize(); ++i)
+		{
+			C4String *pKey = p->Shape->GetKey(i);
+			if (pKey != &::Strings.P[P_Prototype])
+				if (!prefix || pKey->GetData().BeginsWith(prefix))
+					result.push_back(pKey);
+		}
 		p = p->GetPrototype();
 		if (p == ignore_parent) break;
 	} while (p);
@@ -756,9 +798,9 @@ unsigned int C4Set<C4Property>::Hash<C4Property>(C4Property const & p)
 
 bool C4PropList::GetPropertyByS(const C4String * k, C4Value *pResult) const
 {
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		*pResult = Properties.Get(k).Value;
+		*pResult = *pValue;
 		return true;
 	}
 	else if (k == &Strings.P[P_Prototype])
@@ -772,12 +814,63 @@ bool C4PropList::GetPropertyByS(const C4String * k, C4Value *pResult) const
 		return false;
 }
 
+bool C4PropList::GetPropertyByS(const C4String * k, C4Value *pResult, C4PropertyCache &Cache) const
+{
+	// only engine properties can be reflected from C++ variables
+	bool fEngineProperty = k >= &Strings.P[0] && k < &Strings.P[P_LAST];
+	if (fEngineProperty && IsReflectedProperty(k))
+		return GetPropertyByS(k, pResult);
+	// own property in a shape seen before? Only shared shapes never change.
+	if (Shape == Cache.Shape && Cache.pKey == k)
+	{
+		*pResult = Values[Cache.iIndex];
+		return true;
+	}
+	int32_t iIndex = Shape->GetIndex(k);
+	if (iIndex >= 0)
+	{
+		if (Shape->IsShared())
+		{
+			Cache.Shape = Shape;
+			Cache.iIndex = iIndex;
+			Cache.pKey = k;
+		}
+		*pResult = Values[iIndex];
+		return true;
+	}
+	const C4PropList *pPrototype = GetPrototype();
+	if (!pPrototype)
+		return false;
+	if (Cache.pPrototypeKey == k && Cache.pPrototype == pPrototype && Cache.iVersion == PrototypeVersion)
+	{
+		if (!Cache.pValue) return false;
+		*pResult = *Cache.pValue;
+		return true;
+	}
+	// Only a chain of static proplists is covered by PrototypeVersion
+	const C4Value *pValue = nullptr;
+	for (const C4PropList *p = pPrototype; p; p = p->GetPrototype())
+	{
+		if (!p->IsStatic() || (fEngineProperty && p->IsReflectedProperty(k)))
+			return pPrototype->GetPropertyByS(k, pResult);
+		if ((pValue = p->GetOwnProperty(k)))
+			break;
+	}
+	Cache.pPrototypeKey = k;
+	Cache.pPrototype = pPrototype;
+	Cache.pValue = pValue;
+	Cache.iVersion = PrototypeVersion;
+	if (!pValue) return false;
+	*pResult = *pValue;
+	return true;
+}
+
 C4String * C4PropList::GetPropertyStr(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getStr();
+		return pValue->getStr();
 	}
 	if (GetPrototype())
 	{
@@ -789,9 +882,9 @@ C4String * C4PropList::GetPropertyStr(C4PropertyName n) const
 C4ValueArray * C4PropList::GetPropertyArray(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getArray();
+		return pValue->getArray();
 	}
 	if (GetPrototype())
 	{
@@ -803,9 +896,9 @@ C4ValueArray * C4PropList::GetPropertyArray(C4PropertyName n) const
 C4AulFunc * C4PropList::GetFunc(C4String * k) const
 {
 	assert(k);
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getFunction();
+		return pValue->getFunction();
 	}
 	if (GetPrototype())
 	{
@@ -855,9 +948,9 @@ C4Value C4PropList::Call(const char * s, C4AulParSet *Pars, bool fPassErrors)
 C4PropertyName C4PropList::GetPropertyP(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		C4String * v = Properties.Get(k).Value.getStr();
+		C4String * v = pValue->getStr();
 		if (v >= &Strings.P[0] && v < &Strings.P[P_LAST])
 			return C4PropertyName(v - &Strings.P[0]);
 		return P_LAST;
@@ -872,9 +965,9 @@ C4PropertyName C4PropList::GetPropertyP(C4PropertyName n) const
 int32_t C4PropList::GetPropertyBool(C4PropertyName n, bool default_val) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getBool();
+		return pValue->getBool();
 	}
 	if (GetPrototype())
 	{
@@ -886,9 +979,9 @@ int32_t C4PropList::GetPropertyBool(C4PropertyName n, bool default_val) const
 int32_t C4PropList::GetPropertyInt(C4PropertyName n, int32_t default_val) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getInt();
+		return pValue->getInt();
 	}
 	if (GetPrototype())
 	{
@@ -900,9 +993,9 @@ int32_t C4PropList::GetPropertyInt(C4PropertyName n, int32_t default_val) const
 C4PropList *C4PropList::GetPropertyPropList(C4PropertyName n) const
 {
 	C4String * k = &Strings.P[n];
-	if (Properties.Has(k))
+	if (const C4Value *pValue = GetOwnProperty(k))
 	{
-		return Properties.Get(k).Value.getPropList();
+		return pValue->getPropList();
 	}
 	if (GetPrototype())
 	{
@@ -920,17 +1013,16 @@ C4ValueArray * C4PropList::GetProperties() const
 	{
 		a = GetPrototype()->GetProperties();
 		i = a->GetSize();
-		a->SetSize(i + Properties.GetSize());
+		a->SetSize(i + Values.size());
 	}
 	else
 	{
-		a = new C4ValueArray(Properties.GetSize());
+		a = new C4ValueArray(Values.size());
 		i = 0;
 	}
-	const C4Property * p = Properties.First();
-	while (p)
+	for (int32_t iProp = 0; iProp < Shape->GetSize(); ++iProp)
 	{
-		C4String *newPropertyName = p->Key;
+		C4String *newPropertyName = Shape->GetKey(iProp);
 		assert(newPropertyName != nullptr && "Proplist key is nullpointer");
 		// Do we need to check for duplicate property names?
 		bool skipProperty = false;
@@ -948,7 +1040,6 @@ C4ValueArray * C4PropList::GetProperties() const
 			(*a)[i++] = C4VString(newPropertyName);
 			assert(((*a)[i - 1].GetType() == C4V_String) && "Proplist key is non-string");
 		}
-		p = Properties.Next(p);
 	}
 	// We might have added less properties than initially intended.
 	if (hasInheritedProperties)
@@ -958,13 +1049,9 @@ C4ValueArray * C4PropList::GetProperties() const
 
 C4String * C4PropList::EnumerateOwnFuncs(C4String * prev) const
 {
-	const C4Property * p = prev ? Properties.Next(&Properties.Get(prev)) : Properties.First();
-	while (p)
-	{
-		if (p->Value.getFunction())
-			return p->Key;
-		p = Properties.Next(p);
-	}
+	for (int32_t i = prev ? Shape->GetIndex(prev) + 1 : 0; i < Shape->GetSize(); ++i)
+		if (Values[i].getFunction())
+			return Shape->GetKey(i);
 	return nullptr;
 }
 
@@ -978,14 +1065,16 @@ void C4PropList::SetPropertyByS(C4String * k, const C4Value & to)
 			if(it == this)
 				throw C4AulExecError("Trying to create cyclic prototype structure");
 		prototype.SetPropList(newpt);
-	}
-	else if (Properties.Has(k))
-	{
-		Properties.Get(k).Value = to;
+		PropertiesChanged();
 	}
 	else
 	{
-		Properties.Add(C4Property(k, to));
+		int32_t i = Shape->GetIndex(k);
+		// values are read through C4PropertyCache::pValue, so this needs no invalidation
+		if (i >= 0)
+			Values[i] = to;
+		else
+			AddProperty(k, to);
 	}
 }
 
@@ -994,7 +1083,64 @@ void C4PropList::ResetProperty(C4String * k)
 	if (k == &Strings.P[P_Prototype])
 		prototype.Set0();
 	else
-		Properties.Remove(k);
+	{
+		int32_t i = Shape->GetIndex(k);
+		if (i < 0) return;
+		// the old value may hold the last reference to something that refers back to this
+		C4Value OldValue(std::move(Values[i]));
+		if (i + 1 < int32_t(Values.size()))
+			Values[i] = std::move(Values.back());
+		Values.pop_back();
+		SetShape(Shape->WithoutKey(i));
+	}
+	PropertiesChanged();
+}
+
+void C4PropList::AddProperty(C4String *k, const C4Value &to)
+{
+	Values.push_back(to);
+	SetShape(Shape->WithKey(k));
+	PropertiesChanged();
+}
+
+void C4PropList::ClearProperties()
+{
+	std::vector<C4Value> OldValues;
+	OldValues.swap(Values);
+	SetShape(C4PropListShape::GetEmpty());
+}
+
+void C4PropList::SwapProperties(C4PropList *pOther)
+{
+	std::swap(Shape, pOther->Shape);
+	Values.swap(pOther->Values);
+	PropertiesChanged();
+	pOther->PropertiesChanged();
+}
+
+void C4PropList::CopyPropertiesTo(C4Set<C4Property> &rTo) const
+{
+	for (int32_t i = 0; i < Shape->GetSize(); ++i)
+		rTo.Add(C4Property(Shape->GetKey(i), Values[i]));
+}
+
+void C4PropList::SetShape(C4PropListShape *pNewShape)
+{
+	// the new shape might only be held by the old one
+	pNewShape->IncRef();
+	Shape->DecRef();
+	Shape = pNewShape;
+}
+
+std::vector<int32_t> C4PropList::GetSortedPropertyIndices() const
+{
+	std::vector<int32_t> Result(Values.size());
+	for (size_t i = 0; i < Result.size(); ++i) Result[i] = i;
+	std::sort(Result.begin(), Result.end(), [this](int32_t a, int32_t b)
+	{
+		return strcmp(Shape->GetKey(a)->GetCStr(), Shape->GetKey(b)->GetCStr()) < 0;
+	});
+	return Result;
 }
 
 void C4PropList::Iterator::Init()
@@ -1007,20 +1153,20 @@ void C4PropList::Iterator::Reserve(size_t additionalAmount)
 	properties->reserve(properties->size() + additionalAmount);
 }
 
-void C4PropList::Iterator::AddProperty(const C4Property * prop)
+void C4PropList::Iterator::AddProperty(C4String *k, const C4Value &v)
 {
-	std::vector<const C4Property*>::size_type i = 0, len = properties->size();
+	std::vector<C4Property>::size_type i = 0, len = properties->size();
 	for(;i < len; ++i)
 	{
-		const C4Property *oldProperty = (*properties)[i];
-		if (oldProperty->Key == prop->Key)
+		C4Property &oldProperty = (*properties)[i];
+		if (oldProperty.Key == k)
 		{
-			(*properties)[i] = prop;
+			oldProperty.Value = v;
 			return;
 		}
 	}
 	// not already in vector?
-	properties->push_back(prop);
+	properties->emplace_back(k, v);
 }
 
 C4PropList::Iterator C4PropList::begin()
@@ -1033,21 +1179,138 @@ C4PropList::Iterator C4PropList::begin()
 	}
 	else
 	{
-		iter.properties = std::make_shared<std::vector<const C4Property*> >();
+		iter.properties = std::make_shared<std::vector<C4Property> >();
 	}
-	iter.Reserve(Properties.GetSize());
+	iter.Reserve(Values.size());
 
-	const C4Property * p = Properties.First();
-	while (p)
-	{
-		iter.AddProperty(p);
-		p = Properties.Next(p);
-	}
+	for (int32_t i = 0; i < Shape->GetSize(); ++i)
+		iter.AddProperty(Shape->GetKey(i), Values[i]);
 
 	iter.Init();
 	return iter;
 }
 
+// shapes with more keys than this get a hash index
+static const int32_t C4PropListShape_MaxScanKeys = 8;
+// proplists with more keys than this get a dictionary shape, to keep the shared ones small
+static const int32_t C4PropListShape_MaxSharedKeys = 64;
+
+C4PropListShape *C4PropListShape::GetEmpty()
+{
+	// referenced forever, so it does not depend on destruction order
+	static C4PropListShape *Empty = nullptr;
+	if (!Empty)
+	{
+		Empty = new C4PropListShape;
+		Empty->IncRef();
+	}
+	return Empty;
+}
+
+C4PropListShape::~C4PropListShape()
+{
+	assert(Children.empty());
+	if (Parent)
+	{
+		Parent->Children.erase(Keys.back());
+		Parent->DecRef();
+	}
+	for (C4String *k : Keys) k->DecRef();
+}
+
+int32_t C4PropListShape::GetIndex(const C4String *k) const
+{
+	if (Index.empty())
+	{
+		for (size_t i = 0; i < Keys.size(); ++i)
+			if (Keys[i] == k)
+				return i;
+		return -1;
+	}
+	size_t iMask = Index.size() - 1;
+	for (size_t h = k->Hash & iMask; Index[h] >= 0; h = (h + 1) & iMask)
+		if (Keys[Index[h]] == k)
+			return Index[h];
+	return -1;
+}
+
+void C4PropListShape::AddKey(C4String *k)
+{
+	Keys.push_back(k);
+	k->IncRef();
+	// keep the index at most half full
+	if (Keys.size() * 2 > Index.size())
+		UpdateIndex();
+	else
+	{
+		size_t iMask = Index.size() - 1, h = k->Hash & iMask;
+		while (Index[h] >= 0) h = (h + 1) & iMask;
+		Index[h] = Keys.size() - 1;
+	}
+}
+
+void C4PropListShape::UpdateIndex()
+{
+	Index.clear();
+	if (int32_t(Keys.size()) <= C4PropListShape_MaxScanKeys) return;
+	size_t iSize = 16;
+	while (iSize < Keys.size() * 4) iSize *= 2;
+	Index.assign(iSize, -1);
+	for (size_t i = 0; i < Keys.size(); ++i)
+	{
+		size_t h = Keys[i]->Hash & (iSize - 1);
+		while (Index[h] >= 0) h = (h + 1) & (iSize - 1);
+		Index[h] = i;
+	}
+}
+
+C4PropListShape *C4PropListShape::GetDictionary()
+{
+	if (!fShared) return this;
+	C4PropListShape *pDict = new C4PropListShape;
+	pDict->fShared = false;
+	pDict->Keys = Keys;
+	for (C4String *k : Keys) k->IncRef();
+	pDict->UpdateIndex();
+	return pDict;
+}
+
+C4PropListShape *C4PropListShape::WithKey(C4String *k)
+{
+	assert(GetIndex(k) < 0);
+	if (!fShared || GetSize() >= C4PropListShape_MaxSharedKeys)
+	{
+		C4PropListShape *pDict = GetDictionary();
+		pDict->AddKey(k);
+		return pDict;
+	}
+	C4PropListShape *&pChild = Children[k];
+	if (!pChild)
+	{
+		pChild = new C4PropListShape;
+		pChild->Parent = this;
+		IncRef();
+		pChild->Keys.reserve(Keys.size() + 1);
+		pChild->Keys = Keys;
+		for (C4String *pKey : Keys) pKey->IncRef();
+		pChild->AddKey(k);
+	}
+	return pChild;
+}
+
+C4PropListShape *C4PropListShape::WithoutKey(int32_t i)
+{
+	// removing the last key goes back to the previous shape
+	if (fShared && i + 1 == GetSize())
+		return Parent;
+	C4PropListShape *pDict = GetDictionary();
+	pDict->Keys[i]->DecRef();
+	pDict->Keys[i] = pDict->Keys.back();
+	pDict->Keys.pop_back();
+	pDict->UpdateIndex();
+	return pDict;
+}
+
 
 template<> template<>
 unsigned int C4Set<C4PropListNumbered *>::Hash<int>(int const & e)
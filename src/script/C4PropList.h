@@ -59,11 +59,61 @@ public:
 	bool operator < (const C4Property &cmp) const { return strcmp(GetSafeKey(), cmp.GetSafeKey())<0; }
 	const char *GetSafeKey() const { if (Key && Key->GetCStr()) return Key->GetCStr(); return ""; } // get key as C string; return "" if undefined. never return nullptr
 };
+
+// The keys of a proplist in the order they were added. Proplists that got the
+// same keys in the same order share their shape and only store the values.
+// Shared shapes never change. A proplist that removes a key from the middle or
+// grows very large gets a dictionary shape of its own, which changes in place.
+class C4PropListShape: public C4RefCnt
+{
+public:
+	~C4PropListShape() override;
+	static C4PropListShape *GetEmpty();
+
+	int32_t GetSize() const { return Keys.size(); }
+	C4String *GetKey(int32_t i) const { return Keys[i]; }
+	int32_t GetIndex(const C4String *k) const; // -1 if k is not part of this shape
+	bool IsShared() const { return fShared; }
+
+	// the shape after adding k as the last key
+	C4PropListShape *WithKey(C4String *k);
+	// the shape after removing the key at index i, with the last key moved to index i
+	C4PropListShape *WithoutKey(int32_t i);
+
+private:
+	C4PropListShape() = default;
+	void AddKey(C4String *k);
+	void UpdateIndex();
+	C4PropListShape *GetDictionary();
+
+	std::vector<C4String *> Keys;
+	std::vector<int32_t> Index; // hash table of key indices for shapes too large to scan
+	C4PropListShape *Parent{nullptr}; // shared shapes: shape without the last key
+	std::unordered_map<const C4String *, C4PropListShape *> Children; // shared shapes with one more key
+	bool fShared{true};
+};
+
+// Remembers where a property read found its value last time, so that repeated
+// reads of the same key from similar proplists can skip the lookups.
+// Own properties are remembered by shape and index. Properties from the prototype
+// chain are remembered by the value they were found in, as long as no static
+// proplist has changed since (see C4PropList::PrototypeVersion).
+struct C4PropertyCache
+{
+	C4RefCntPointer<C4PropListShape> Shape;
+	int32_t iIndex{0};
+	const C4String *pKey{nullptr};
+	const C4String *pPrototypeKey{nullptr};
+	const C4PropList *pPrototype{nullptr};
+	const C4Value *pValue{nullptr}; // nullptr: not found in the prototype chain
+	uint32_t iVersion{0};
+};
+
 class C4PropListNumbered;
 class C4PropList
 {
 public:
-	void Clear() { constant = false; Properties.Clear(); prototype.Set0(); }
+	void Clear() { constant = false; ClearProperties(); prototype.Set0(); PropertiesChanged(); }
 	virtual const char *GetName() const;
 	virtual void SetName (const char *NewName = nullptr);
 	virtual void SetOnFire(bool OnFire) { }
@@ -92,6 +142,10 @@ public:
 	// These four operate on properties as seen by script, which can be dynamic
 	// or reflect C++ variables
 	virtual bool GetPropertyByS(const C4String *k, C4Value *pResult) const;
+	// same result as GetPropertyByS, but remembers the lookup for the next call with the same cache
+	bool GetPropertyByS(const C4String *k, C4Value *pResult, C4PropertyCache &Cache) const;
+	// whether GetPropertyByS takes k from somewhere other than the property table
+	virtual bool IsReflectedProperty(const C4String *k) const { return k == &Strings.P[P_Prototype]; }
 	virtual C4ValueArray * GetProperties() const;
 	// not allowed on frozen proplists
 	virtual void SetPropertyByS(C4String * k, const C4Value & to);
@@ -115,7 +169,7 @@ public:
 	int32_t GetPropertyBool(C4PropertyName n, bool default_val = false) const;
 	int32_t GetPropertyInt(C4PropertyName k, int32_t default_val = 0) const;
 	C4PropList *GetPropertyPropList(C4PropertyName k) const;
-	bool HasProperty(C4String * k) const { return Properties.Has(k); }
+	bool HasProperty(C4String * k) const { return Shape->GetIndex(k) >= 0; }
 	// not allowed on frozen proplists
 	void SetProperty(C4PropertyName k, const C4Value & to)
 	{ SetPropertyByS(&Strings.P[k], to); }
@@ -147,6 +201,10 @@ public:
 	std::vector< C4String * > GetSortedProperties(const char *prefix, C4PropList *ignore_parent = nullptr) const;
 
 	bool operator==(const C4PropList &b) const;
+
+	// changed whenever properties are added to or removed from a static proplist or its prototype
+	// changes, which invalidates the prototype chain part of all C4PropertyCaches
+	static uint32_t PrototypeVersion;
 #ifdef _DEBUG
 	static C4Set<C4PropList *> PropLists;
 #endif	
@@ -154,12 +212,23 @@ public:
 protected:
 	C4PropList(C4PropList * prototype = nullptr);
 	void ClearRefs() { while (FirstRef) FirstRef->Set0(); }
+	void PropertiesChanged() { if (IsStatic()) ++PrototypeVersion; }
 
 private:
 	void AddRef(C4Value *pRef);
 	void DelRef(const C4Value *pRef, C4Value * pNextRef);
+	void SetShape(C4PropListShape *pNewShape);
+	const C4Value *GetOwnProperty(const C4String *k) const
+	{ int32_t i = Shape->GetIndex(k); return i >= 0 ? &Values[i] : nullptr; }
+	void AddProperty(C4String *k, const C4Value &to);
+	void ClearProperties();
+	void SwapProperties(C4PropList *pOther);
+	void CopyPropertiesTo(C4Set<C4Property> &rTo) const;
+	void MovePropertiesTo(C4Set<C4Property> &rTo) { CopyPropertiesTo(rTo); ClearProperties(); }
+	std::vector<int32_t> GetSortedPropertyIndices() const;
 	C4Value *FirstRef{nullptr}; // No-Save
-	C4Set<C4Property> Properties;
+	C4PropListShape *Shape; // keys of the properties
+	std::vector<C4Value> Values; // values of the properties, in the order of Shape's keys
 	C4Value prototype;
 	bool constant{false}; // if true, this proplist is not changeable
 	friend class C4Value;
@@ -170,19 +239,19 @@ public:
 	class Iterator
 	{
 	private:
-		std::shared_ptr<std::vector<const C4Property*> > properties;
-		std::vector<const C4Property*>::iterator iter;
+		std::shared_ptr<std::vector<C4Property> > properties;
+		std::vector<C4Property>::iterator iter;
 		// needed when constructing the iterator
 		// adds a property or overwrites existing property with same name
-		void AddProperty(const C4Property * prop);
+		void AddProperty(C4String *k, const C4Value &v);
 		void Reserve(size_t additionalAmount);
 		// Initializes internal iterator. Needs to be called before actually using the iterator.
 		void Init();
 	public:
 		Iterator() : properties(nullptr) { }
 
-		const C4Property * operator*() const { return *iter; }
-		const C4Property * operator->() const { return *iter; }
+		const C4Property * operator*() const { return &*iter; }
+		const C4Property * operator->() const { return &*iter; }
 		void operator++() { ++iter; };
 		void operator++(int) { operator++(); }
 
@@ -261,7 +330,7 @@ class C4PropListStatic: public C4PropList
 public:
 	C4PropListStatic(C4PropList * prototype, const C4PropListStatic * parent, C4String * key):
 		C4PropList(prototype), Parent(parent), ParentKeyName(key) { }
-	~C4PropListStatic() override = default;
+	~C4PropListStatic() override { ++PrototypeVersion; }
 	bool Delete() override { return true; }
 	C4PropListStatic * IsStatic() override { return this; }
 	void RefCompileFunc(StdCompiler *pComp, C4ValueNumbers * numbers) const;
@@ -108,6 +108,7 @@ protected:
 	friend class C4AulDebug;
 	friend class C4AulCompiler;
 	friend class C4AulScriptFunc;
+	friend class C4AulCodeCache;
 
 private:
 	std::map<const char*, std::bitset<(size_t)C4AulWarningId::WarningCount>> enabledWarnings;
@@ -0,0 +1,113 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "c4group/C4Group.h"
+
+#include <gtest/gtest.h>
+
+static const char *szTestGroup = "C4GroupTest.ocd";
+
+static const C4GroupEntry *FindEntry(const C4Group &Grp, const char *szName)
+{
+	for (const C4GroupEntry *pEntry = Grp.GetFirstEntry(); pEntry; pEntry = pEntry->Next)
+		if (SEqual(pEntry->FileName, szName) && pEntry->Status != C4GroupEntry::C4GRES_Deleted)
+			return pEntry;
+	return nullptr;
+}
+
+static void CheckContents(C4Group &Grp, const StdStrBuf &Text, bool fIndexed)
+{
+	EXPECT_EQ(fIndexed, Grp.IsIndexed());
+	// read out of order
+	StdStrBuf Buf;
+	EXPECT_TRUE(Grp.LoadEntryString("Small.txt", &Buf));
+	EXPECT_STREQ("x", Buf.getData());
+	EXPECT_TRUE(Grp.LoadEntryString("Text.txt", &Buf));
+	EXPECT_STREQ(Text.getData(), Buf.getData());
+	EXPECT_TRUE(Grp.LoadEntryString("Small.txt", &Buf));
+	EXPECT_STREQ("x", Buf.getData());
+	const C4GroupEntry *pText = FindEntry(Grp, "Text.txt"), *pSmall = FindEntry(Grp, "Small.txt");
+	ASSERT_TRUE(pText && pSmall);
+	EXPECT_EQ(fIndexed, !!pText->Packed);
+	EXPECT_FALSE(pSmall->Packed);
+	// nested groups
+	C4Group Child;
+	ASSERT_TRUE(Child.OpenAsChild(&Grp, "Child.ocd"));
+	EXPECT_EQ(fIndexed, Child.IsIndexed());
+	EXPECT_TRUE(Child.LoadEntryString("Nested.txt", &Buf));
+	EXPECT_STREQ(Text.getData(), Buf.getData());
+	// only indexed children can be cached without going through the mother's file
+	EXPECT_EQ(fIndexed, Child.CanPreCacheConcurrently());
+	Child.PreCacheEntries("*.txt");
+	EXPECT_TRUE(Child.LoadEntryString("Nested.txt", &Buf));
+	EXPECT_STREQ(Text.getData(), Buf.getData());
+	Child.Close();
+	EXPECT_TRUE(Grp.LoadEntryString("Text.txt", &Buf));
+	EXPECT_STREQ(Text.getData(), Buf.getData());
+	// views map uncompressed entries of indexed groups and copy everything else
+	StdBuf View;
+	EXPECT_TRUE(Grp.LoadEntryView("Small.txt", &View));
+	ASSERT_EQ(1u, View.getSize());
+	EXPECT_EQ('x', *getBufPtr<char>(View));
+	EXPECT_EQ(fIndexed, View.isRef());
+	EXPECT_TRUE(Grp.LoadEntryView("Text.txt", &View));
+	ASSERT_EQ(Text.getLength(), View.getSize());
+	EXPECT_EQ(0, memcmp(Text.getData(), View.getData(), View.getSize()));
+	EXPECT_FALSE(View.isRef());
+}
+
+TEST(C4GroupTest, Indexed)
+{
+	EraseItem(szTestGroup);
+	StdStrBuf Text, Small("x");
+	for (int i = 0; i < 1000; ++i)
+		Text.AppendFormat("Line %d\n", i);
+	{
+		C4Group Grp;
+		ASSERT_TRUE(Grp.Open(szTestGroup, true));
+		ASSERT_TRUE(Grp.SetIndexed(true));
+		EXPECT_TRUE(Grp.Add("Text.txt", Text));
+		EXPECT_TRUE(Grp.Add("Small.txt", Small));
+		// new children take the format of their mother
+		C4Group Child;
+		ASSERT_TRUE(Child.OpenAsChild(&Grp, "Child.ocd", false, true));
+		EXPECT_TRUE(Child.Add("Nested.txt", Text));
+		EXPECT_TRUE(Child.Close());
+		EXPECT_TRUE(Grp.Close());
+	}
+	{
+		C4Group Grp;
+		ASSERT_TRUE(Grp.Open(szTestGroup));
+		CheckContents(Grp, Text, true);
+		// convert back
+		EXPECT_TRUE(Grp.SetIndexed(false, true));
+		EXPECT_TRUE(Grp.Close());
+	}
+	{
+		C4Group Grp;
+		ASSERT_TRUE(Grp.Open(szTestGroup));
+		CheckContents(Grp, Text, false);
+		// and forth again
+		EXPECT_TRUE(Grp.SetIndexed(true, true));
+		EXPECT_TRUE(Grp.Close());
+	}
+	{
+		C4Group Grp;
+		ASSERT_TRUE(Grp.Open(szTestGroup));
+		CheckContents(Grp, Text, true);
+	}
+	EraseItem(szTestGroup);
+}
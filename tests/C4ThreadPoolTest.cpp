@@ -0,0 +1,56 @@
+/*
+ * OpenClonk, http://www.openclonk.org
+ *
+ * Copyright (c) 2016, The OpenClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include "platform/C4ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+static void CheckCoverage(C4ThreadPool &Pool, size_t iCount, size_t iMinSlice)
+{
+	std::vector<int> Visits(iCount, 0);
+	Pool.ParallelFor(iCount, iMinSlice, [&Visits](size_t iBegin, size_t iEnd)
+	{
+		EXPECT_LT(iBegin, iEnd);
+		for (size_t i = iBegin; i < iEnd; ++i) ++Visits[i];
+	});
+	for (size_t i = 0; i < iCount; ++i)
+		EXPECT_EQ(1, Visits[i]) << "index " << i << " of " << iCount;
+}
+
+TEST(C4ThreadPoolTest, NoWorkers)
+{
+	C4ThreadPool Pool;
+	EXPECT_FALSE(Pool.IsParallel());
+	CheckCoverage(Pool, 0, 16);
+	CheckCoverage(Pool, 1000, 16);
+}
+
+TEST(C4ThreadPoolTest, Workers)
+{
+	C4ThreadPool Pool;
+	Pool.SetWorkerCount(3);
+	EXPECT_EQ(3, Pool.GetWorkerCount());
+	for (size_t iCount : { 1, 15, 16, 17, 1000, 12345 })
+		CheckCoverage(Pool, iCount, 16);
+	// repeated jobs and resizing
+	for (int i = 0; i < 100; ++i)
+		CheckCoverage(Pool, 500, 1);
+	Pool.SetWorkerCount(1);
+	CheckCoverage(Pool, 500, 1);
+	Pool.SetWorkerCount(0);
+	EXPECT_FALSE(Pool.IsParallel());
+	CheckCoverage(Pool, 500, 1);
+}
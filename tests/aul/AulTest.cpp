@@ -20,6 +20,8 @@
 #include "AulTest.h"
 #include "ErrorHandler.h"
 
+#include "script/C4AulCodeCache.h"
+#include "script/C4AulExec.h"
 #include "script/C4ScriptHost.h"
 #include "lib/C4Random.h"
 #include "object/C4DefList.h"
@@ -218,6 +220,143 @@ func Main() { return b->c(); }
 	EXPECT_THROW(RunScript("func foo() { return { bar: func() {} }; }"), C4AulError);
 }
 
+TEST_F(AulTest, PropertyCache)
+{
+	// the same read from proplists with different layouts and prototypes
+	EXPECT_EQ(C4VInt(3 * (1 + 2 + 3 + 4 + 3)), RunScript(R"(
+static const base = { x = 3 };
+func Main() {
+	var dyn = { x = 3 };
+	var a = [{ x = 1 }, { y = 0, x = 2 }, new base {}, new base { x = 4 }, { y = 5 }, new dyn {}];
+	var sum = 0;
+	for (var rep = 0; rep < 3; rep++)
+		for (var p in a)
+			sum += p.x;
+	return sum;
+}
+)"));
+	// changes after the read was cached
+	EXPECT_EQ(C4VInt(3 + 7 + 5 + 0), RunScript(R"(
+static const base = { x = 3 };
+func Main() {
+	var p = new base {}, dyn = { x = 5 }, sum = 0;
+	for (var rep = 0; rep < 4; rep++)
+	{
+		sum += p.x;
+		if (rep == 0) p.x = 7;
+		if (rep == 1) p = new dyn {};
+		if (rep == 2) dyn.x = nil;
+	}
+	return sum;
+}
+)"));
+}
+
+TEST_F(AulTest, PropertyShapes)
+{
+	// proplists sharing a shape until one of them removes a key
+	EXPECT_EQ(C4VInt(23031), RunCode(R"(
+var a = { x = 1, y = 2, z = 3 }, b = { x = 10, y = 20, z = 30 };
+ResetProperty("y", a);
+return a.x + a.z * 10 + b.y * 100 + (a.y == nil) * 1000 + GetLength(GetProperties(a)) * 10000;
+)"));
+	// removing and re-adding the last key
+	EXPECT_EQ(C4VInt(151), RunCode(R"(
+var a = { x = 1, y = 2 };
+ResetProperty("y", a);
+a.y = 5;
+a.z = 1;
+return a.x * 100 + a.y * 10 + a.z;
+)"));
+	// many keys
+	EXPECT_EQ(C4VInt(502500), RunCode(R"(
+var p = {};
+for (var i = 0; i < 100; i++) p[Format("k%d", i)] = i;
+for (var i = 0; i < 100; i += 2) ResetProperty(Format("k%d", i), p);
+var sum = 0;
+for (var i = 0; i < 100; i++) sum += p[Format("k%d", i)];
+return sum + GetLength(GetProperties(p)) * 10000;
+)"));
+}
+
+TEST_F(AulTest, Sampler)
+{
+	AulSampler.Start(20);
+	EXPECT_EQ(C4VInt(0), RunScript(R"(
+func Inner(int i) { return Abs(i) - i; }
+func Main() {
+	var sum = 0;
+	for (var i = 0; i < 200000; i++) sum += Inner(i);
+	return sum;
+}
+)"));
+	AulSampler.Stop();
+	ASSERT_GT(AulSampler.GetSampleCount(), 0u);
+	// one line per stack, outermost function first
+	std::string Stacks(AulSampler.GetCollapsedStacks().getData());
+	EXPECT_NE(std::string::npos, Stacks.find(".Main;"));
+	EXPECT_NE(std::string::npos, Stacks.find(".Inner"));
+	EXPECT_EQ('\n', Stacks.back());
+}
+
+TEST_F(AulTest, FusedBytecode)
+{
+	// comparisons directly followed by a conditional jump
+	EXPECT_EQ(C4VInt(111111), RunCode(R"(
+var a = 1, b = 2, r = 0;
+if (a < b) r += 1;
+if (b <= b) r += 10;
+if (b > a) r += 100;
+if (a >= a) r += 1000;
+if (a == 1) r += 10000;
+if (a != nil) r += 100000;
+if (a > b || a == b || nil != nil) r = 0;
+return r;
+)"));
+	EXPECT_EQ(C4VInt(45), RunCode("var s = 0; for (var i = 0; i < 10; i++) s += i; return s;"));
+	EXPECT_EQ(C4VInt(55), RunCode("var s = 0, i = 10; while (i > 0) { s += i; i--; } return s;"));
+	EXPECT_THROW(RunCode(R"(var a = "x"; if (a < 1) return 1; return 0;)"), C4AulExecError);
+	// two variables loaded in a row, the second one assigned to
+	EXPECT_EQ(C4VInt(10), RunCode("var x = 1, y = 2; return Max(x, y = 5) + y;"));
+	EXPECT_EQ(C4VInt(1), RunCode("var x = 1, y = 2; return Max(x, y += 5) + (x - y);"));
+}
+
+TEST_F(AulTest, CodeCache)
+{
+	const char *szCacheFile = "AulTestCodeCache.bin";
+	EraseItem(szCacheFile);
+	const C4Value Expected = C4VArray(C4VInt(4), C4VInt(2), C4VInt(5), C4VString("abc"), C4VInt(3));
+	const std::string Script = R"(
+static const Offsets = [4, 2];
+static const Info = { Name = "abc" };
+func Sum(a, b) { return a + b; }
+func Main() { return [Offsets[0], Offsets[1], Sum(Abs(-2), 3), Info.Name, GetLength(Offsets) + 1]; }
+)";
+	// first run generates the code and writes the file
+	ScriptEngine.SetCodeCache(szCacheFile, "test");
+	EXPECT_EQ(Expected, RunScript(Script));
+	EXPECT_EQ(0, ScriptEngine.GetCodeCache()->GetRestoredCount());
+	// same scripts again: code is taken from the file
+	ScriptEngine.SetCodeCache(szCacheFile, "test");
+	part_count = 0;
+	EXPECT_EQ(Expected, RunScript(Script));
+	EXPECT_LT(0, ScriptEngine.GetCodeCache()->GetRestoredCount());
+	// any change compiles everything anew
+	ScriptEngine.SetCodeCache(szCacheFile, "test");
+	part_count = 0;
+	std::string Changed = Script;
+	Changed.replace(Changed.find("a + b"), 5, "a * b");
+	EXPECT_EQ(C4VArray(C4VInt(4), C4VInt(2), C4VInt(6), C4VString("abc"), C4VInt(3)), RunScript(Changed));
+	EXPECT_EQ(0, ScriptEngine.GetCodeCache()->GetRestoredCount());
+	// as does another engine version
+	ScriptEngine.SetCodeCache(szCacheFile, "other");
+	part_count = 0;
+	EXPECT_EQ(Expected, RunScript(Script));
+	EXPECT_EQ(0, ScriptEngine.GetCodeCache()->GetRestoredCount());
+	ScriptEngine.SetCodeCache(nullptr, nullptr);
+	EraseItem(szCacheFile);
+}
+
 TEST_F(AulTest, Eval)
 {
 	EXPECT_EQ(C4VInt(42), RunExpr("eval(\"42\")"));
@@ -37,8 +37,7 @@ protected:
 
 	virtual void SetUp() override;
 
-private:
-	int part_count = 0;
+	int part_count = 0; // numbers the scripts run by one test
 };
 
 namespace aul_test {